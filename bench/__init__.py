@@ -0,0 +1,18 @@
+"""
+Benchmark Suite
+Reproducible microbenchmarks for the memory/hook framework
+
+Each benchmark is a runnable module emitting JSON so regressions can
+be tracked release over release:
+
+    python -m bench.bench_state_read
+    python -m bench.bench_command_rtt
+    python -m bench.bench_reset --live
+    python -m bench.bench_throughput
+    python -m bench.soak --live --duration 120
+
+State-read and throughput benchmarks run against MockMemoryReader (a
+synthetic in-process board) by default, so framework latency is
+measurable without a live game; command RTT uses a loopback mock hook
+server. Pass --live to target a running, injected game instead.
+"""
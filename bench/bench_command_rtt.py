@@ -0,0 +1,64 @@
+"""
+Command RTT Benchmark
+HookClient plant/shovel round-trip latency
+
+Usage:
+    python -m bench.bench_command_rtt              # loopback mock server
+    python -m bench.bench_command_rtt --live       # injected game on 12345
+"""
+
+import argparse
+
+from bench.common import time_calls, percentiles, emit_report
+from bench.mock import MockHookServer
+from hook_client.client import HookClient
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('--iterations', type=int, default=500)
+    parser.add_argument('--live', action='store_true',
+                        help='Target a live injected game instead of the mock')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=12345)
+    parser.add_argument('--output', help='Write JSON report to this file')
+    args = parser.parse_args()
+
+    server = None
+    if args.live:
+        client = HookClient(host=args.host, port=args.port)
+    else:
+        server = MockHookServer()
+        server.start()
+        client = HookClient(port=server.port)
+
+    if not client.connect():
+        parser.error("Failed to connect to hook server")
+
+    try:
+        results = {
+            'plant': percentiles(time_calls(
+                lambda: client.plant(0, 8, 0), args.iterations)),
+            'shovel': percentiles(time_calls(
+                lambda: client.shovel(0, 8), args.iterations)),
+            'batch_4': percentiles(time_calls(
+                lambda: client.execute_batch(
+                    ["PLANT 0 8 0", "PLANT 1 8 0",
+                     "SHOVEL 0 8", "SHOVEL 1 8"]),
+                args.iterations)) if args.live else None,
+        }
+        if results['batch_4'] is None:
+            del results['batch_4']  # mock server has no BATCH
+    finally:
+        client.disconnect()
+        if server:
+            server.stop()
+
+    emit_report('command_rtt',
+                {'iterations': args.iterations, 'live': args.live,
+                 'target': f"{args.host}:{args.port}" if args.live else 'mock'},
+                results, args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,75 @@
+"""
+Reset Benchmark
+restart_level to first-actionable-frame latency (live game only)
+
+Measures how long a RESET takes until the rebuilt board is readable
+and the game clock is advancing again — the fixed cost every training
+episode pays.
+
+Usage:
+    python -m bench.bench_reset --live
+"""
+
+import argparse
+import time
+
+from bench.common import percentiles, emit_report
+from hook_client.client import HookClient
+
+
+def measure_reset(client: HookClient, timeout: float = 10.0) -> float:
+    """
+    Reset the level and wait for the first actionable frame
+
+    Returns:
+        Wall time in milliseconds, or -1.0 on timeout
+    """
+    start = time.perf_counter()
+    if not client.reset():
+        return -1.0
+
+    deadline = start + timeout
+    while time.perf_counter() < deadline:
+        state = client.get_state()
+        # Actionable: board rebuilt, clock running from zero
+        if state and state.get('in_game') and 0 < state.get('game_clock', 0) < 500:
+            return (time.perf_counter() - start) * 1000.0
+    return -1.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('--resets', type=int, default=20)
+    parser.add_argument('--live', action='store_true', required=True,
+                        help='Requires a live injected game')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=12345)
+    parser.add_argument('--output', help='Write JSON report to this file')
+    args = parser.parse_args()
+
+    client = HookClient(host=args.host, port=args.port)
+    if not client.connect():
+        parser.error("Failed to connect to hook server")
+
+    samples = []
+    failures = 0
+    try:
+        for _ in range(args.resets):
+            elapsed = measure_reset(client)
+            if elapsed < 0:
+                failures += 1
+            else:
+                samples.append(elapsed)
+    finally:
+        client.disconnect()
+
+    emit_report('reset',
+                {'resets': args.resets,
+                 'target': f"{args.host}:{args.port}"},
+                {'reset_to_actionable': percentiles(samples),
+                 'failures': failures},
+                args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,71 @@
+"""
+State-Read Benchmark
+GameReader.read_game_state / read_state_delta latency vs. zombie count
+
+Usage:
+    python -m bench.bench_state_read
+    python -m bench.bench_state_read --zombies 10,50,100 --output state.json
+    python -m bench.bench_state_read --live
+"""
+
+import argparse
+
+from bench.common import time_calls, percentiles, emit_report
+from bench.mock import MockMemoryReader
+from game.reader import GameReader
+
+
+def bench_reader(reader, iterations: int) -> dict:
+    """Run all read variants against one backend"""
+    bulk = GameReader(reader, bulk=True)
+    per_field = GameReader(reader, bulk=False)
+    recycled = GameReader(reader, bulk=True, recycle=True)
+    delta = GameReader(reader, bulk=True)
+
+    return {
+        'read_game_state_bulk': percentiles(
+            time_calls(bulk.read_game_state, iterations)),
+        'read_game_state_per_field': percentiles(
+            time_calls(per_field.read_game_state, max(iterations // 10, 10))),
+        'read_game_state_recycled': percentiles(
+            time_calls(recycled.read_game_state, iterations)),
+        'read_state_delta': percentiles(
+            time_calls(lambda: delta.read_state_delta(), iterations)),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('--zombies', default='10,50,100',
+                        help='Comma-separated zombie counts (mock mode)')
+    parser.add_argument('--plants', type=int, default=20,
+                        help='Plant count on the mock board')
+    parser.add_argument('--iterations', type=int, default=500)
+    parser.add_argument('--live', action='store_true',
+                        help='Measure the attached game instead of the mock')
+    parser.add_argument('--output', help='Write JSON report to this file')
+    args = parser.parse_args()
+
+    results = {}
+    if args.live:
+        from memory.process import ProcessAttacher
+        from memory.reader import MemoryReader
+        attacher = ProcessAttacher()
+        if not attacher.attach():
+            parser.error("No running PVZ process found")
+        reader = MemoryReader(attacher.kernel32, attacher.process_handle)
+        results['live'] = bench_reader(reader, args.iterations)
+    else:
+        for count in (int(c) for c in args.zombies.split(',')):
+            reader = MockMemoryReader(zombie_count=count,
+                                      plant_count=args.plants)
+            results[f'zombies_{count}'] = bench_reader(reader, args.iterations)
+
+    emit_report('state_read',
+                {'zombies': args.zombies, 'plants': args.plants,
+                 'iterations': args.iterations, 'live': args.live},
+                results, args.output)
+
+
+if __name__ == '__main__':
+    main()
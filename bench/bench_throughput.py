@@ -0,0 +1,86 @@
+"""
+Throughput Benchmark
+Steps/sec for a main.py-style poll-decide loop
+
+Mock mode measures pure framework throughput (read state, run the
+planner queries main.py uses, advance the synthetic clock). Live mode
+polls the attached game for a fixed duration.
+
+Usage:
+    python -m bench.bench_throughput
+    python -m bench.bench_throughput --live --duration 30
+"""
+
+import argparse
+import time
+
+from bench.common import emit_report
+from bench.mock import MockMemoryReader
+from game.reader import GameReader
+
+
+def run_loop(reader, duration: float, tick=None) -> dict:
+    """
+    Run the poll-decide loop for a fixed duration
+
+    Args:
+        reader: MemoryReader backend
+        duration: Seconds to run
+        tick: Optional callable advancing the mock board per step
+
+    Returns:
+        Dict with steps and steps/sec
+    """
+    game_reader = GameReader(reader, recycle=True)
+    steps = 0
+    start = time.perf_counter()
+    end = start + duration
+    while time.perf_counter() < end:
+        state = game_reader.read_game_state()
+        # The queries the decision loop runs every step
+        state.get_most_threatened_row()
+        state.get_usable_seeds()
+        for row in range(5):
+            state.get_zombies_in_row(row)
+        if tick:
+            tick()
+        steps += 1
+    elapsed = time.perf_counter() - start
+    return {'steps': steps, 'seconds': elapsed,
+            'steps_per_sec': steps / elapsed}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('--duration', type=float, default=5.0,
+                        help='Seconds per configuration')
+    parser.add_argument('--zombies', default='10,50,100',
+                        help='Comma-separated zombie counts (mock mode)')
+    parser.add_argument('--live', action='store_true',
+                        help='Poll the attached game instead of the mock')
+    parser.add_argument('--output', help='Write JSON report to this file')
+    args = parser.parse_args()
+
+    results = {}
+    if args.live:
+        from memory.process import ProcessAttacher
+        from memory.reader import MemoryReader
+        attacher = ProcessAttacher()
+        if not attacher.attach():
+            parser.error("No running PVZ process found")
+        reader = MemoryReader(attacher.kernel32, attacher.process_handle)
+        results['live'] = run_loop(reader, args.duration)
+    else:
+        for count in (int(c) for c in args.zombies.split(',')):
+            reader = MockMemoryReader(zombie_count=count)
+            results[f'zombies_{count}'] = run_loop(
+                reader, args.duration, tick=reader.tick)
+
+    emit_report('throughput',
+                {'duration': args.duration, 'zombies': args.zombies,
+                 'live': args.live},
+                results, args.output)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,84 @@
+"""
+Benchmark Helpers
+Shared timing, percentile and JSON-reporting utilities
+"""
+
+import json
+import sys
+import time
+from datetime import datetime
+from typing import Callable, Dict, List
+
+
+def time_calls(fn: Callable[[], object], iterations: int,
+               warmup: int = 50) -> List[float]:
+    """
+    Time repeated calls of fn
+
+    Args:
+        fn: Zero-argument callable to measure
+        iterations: Number of measured calls
+        warmup: Unmeasured calls beforehand (cache/JIT warmup)
+
+    Returns:
+        Per-call wall times in milliseconds
+    """
+    for _ in range(warmup):
+        fn()
+    samples = []
+    for _ in range(iterations):
+        start = time.perf_counter()
+        fn()
+        samples.append((time.perf_counter() - start) * 1000.0)
+    return samples
+
+
+def percentiles(samples: List[float]) -> Dict[str, float]:
+    """
+    Summarize a latency sample list
+
+    Returns:
+        Dict with count/mean/p50/p90/p99/max in milliseconds
+    """
+    if not samples:
+        return {'count': 0}
+    ordered = sorted(samples)
+
+    def pct(p: float) -> float:
+        k = min(len(ordered) - 1, int(round(p * (len(ordered) - 1))))
+        return ordered[k]
+
+    return {
+        'count': len(ordered),
+        'mean_ms': sum(ordered) / len(ordered),
+        'p50_ms': pct(0.50),
+        'p90_ms': pct(0.90),
+        'p99_ms': pct(0.99),
+        'max_ms': ordered[-1],
+    }
+
+
+def emit_report(benchmark: str, params: dict, results, output: str = None):
+    """
+    Emit a benchmark report as JSON
+
+    Args:
+        benchmark: Benchmark name
+        params: Input parameters used for the run
+        results: Benchmark-specific result payload
+        output: File path, or None for stdout
+    """
+    report = {
+        'benchmark': benchmark,
+        'timestamp': datetime.now().isoformat(timespec='seconds'),
+        'python': sys.version.split()[0],
+        'params': params,
+        'results': results,
+    }
+    text = json.dumps(report, indent=2)
+    if output:
+        with open(output, 'w') as f:
+            f.write(text + '\n')
+        print(f"Report written to {output}")
+    else:
+        print(text)
@@ -0,0 +1,216 @@
+"""
+Mock Backends
+Synthetic board and loopback hook server for gameless benchmarking
+"""
+
+import socket
+import struct
+import threading
+from typing import Optional
+
+from data.offsets import Offset
+from memory.reader import MemoryReader
+
+# Image layout (addresses inside the synthetic memory image)
+_BASE_STRUCT = 0x100000
+_BOARD = 0x200000
+_ZOMBIE_ARRAY = 0x300000
+_PLANT_ARRAY = 0x400000
+_SEED_ARRAY = 0x500000
+_ITEM_ARRAY = 0x580000
+_IMAGE_SIZE = 0x6B0000  # must cover Offset.BASE
+
+
+class MockMemoryReader(MemoryReader):
+    """
+    MemoryReader over an in-process synthetic board
+
+    Lays out a byte image with the same pointer chains and entity
+    array layouts the real game uses, then serves the primitive
+    read_* calls from it. GameReader and PVZMemoryInterface run
+    unmodified on top, so benchmarks measure pure framework cost
+    with zero cross-process syscalls.
+    """
+
+    def __init__(self, zombie_count: int = 50, plant_count: int = 20,
+                 zombie_capacity: int = 100, plant_capacity: int = 45):
+        """
+        Build the synthetic board
+
+        Args:
+            zombie_count: Number of alive zombies
+            plant_count: Number of alive plants
+            zombie_capacity: Zombie array slot count (dead slots padded)
+            plant_capacity: Plant array slot count
+        """
+        # No kernel32/process handle: all reads come from the image
+        self.kernel32 = None
+        self.process = None
+        self.mem = bytearray(_IMAGE_SIZE)
+        self.zombie_count = zombie_count
+        self.plant_count = plant_count
+        self.zombie_capacity = zombie_capacity
+        self.plant_capacity = plant_capacity
+        self._build_image()
+
+    # Primitive reads, served from the image -------------------------------
+
+    def read_int(self, address: int) -> int:
+        return struct.unpack_from('<i', self.mem, address)[0]
+
+    def read_uint(self, address: int) -> int:
+        return struct.unpack_from('<I', self.mem, address)[0]
+
+    def read_float(self, address: int) -> float:
+        return struct.unpack_from('<f', self.mem, address)[0]
+
+    def read_short(self, address: int) -> int:
+        return struct.unpack_from('<h', self.mem, address)[0]
+
+    def read_double(self, address: int) -> float:
+        return struct.unpack_from('<d', self.mem, address)[0]
+
+    def read_byte(self, address: int) -> int:
+        return self.mem[address]
+
+    def read_bool(self, address: int) -> bool:
+        return self.mem[address] != 0
+
+    def read_bytes(self, address: int, size: int) -> bytes:
+        return bytes(self.mem[address:address + size])
+
+    # Image construction ----------------------------------------------------
+
+    def _wi(self, addr: int, value: int):
+        struct.pack_into('<i', self.mem, addr, value)
+
+    def _wf(self, addr: int, value: float):
+        struct.pack_into('<f', self.mem, addr, value)
+
+    def _build_image(self):
+        self._wi(Offset.BASE, _BASE_STRUCT)
+        self._wi(_BASE_STRUCT + Offset.MAIN_OBJECT, _BOARD)
+        self._wi(_BASE_STRUCT + Offset.GAME_UI, 3)  # in game
+
+        board = _BOARD
+        self._wi(board + Offset.SUN, 1000)
+        self._wi(board + Offset.WAVE, 5)
+        self._wi(board + Offset.TOTAL_WAVE, 20)
+        self._wi(board + Offset.GAME_CLOCK, 1)
+        self._wi(board + Offset.SCENE, 2)  # pool
+        self._wi(board + Offset.ZOMBIE_ARRAY, _ZOMBIE_ARRAY)
+        self._wi(board + Offset.ZOMBIE_COUNT_MAX, self.zombie_capacity)
+        self._wi(board + Offset.PLANT_ARRAY, _PLANT_ARRAY)
+        self._wi(board + Offset.PLANT_COUNT_MAX, self.plant_capacity)
+        self._wi(board + Offset.SEED_ARRAY, _SEED_ARRAY)
+        self._wi(board + Offset.ITEM_ARRAY, _ITEM_ARRAY)
+        self._wi(board + Offset.ITEM_COUNT_MAX, 0)
+
+        for i in range(self.zombie_capacity):
+            addr = _ZOMBIE_ARRAY + i * Offset.ZOMBIE_SIZE
+            if i < self.zombie_count:
+                self._wi(addr + Offset.Z_ROW, i % 5)
+                self._wf(addr + Offset.Z_X, 400.0 + (i * 37) % 400)
+                self._wf(addr + Offset.Z_Y, 80.0 + (i % 5) * 100)
+                self._wi(addr + Offset.Z_TYPE, i % 12)
+                self._wi(addr + Offset.Z_HP, 270 + i)
+                self._wi(addr + Offset.Z_HP_MAX, 270)
+                self._wf(addr + Offset.Z_SPEED, 0.23)
+            else:
+                self.mem[addr + Offset.Z_DEAD] = 1
+
+        for i in range(self.plant_capacity):
+            addr = _PLANT_ARRAY + i * Offset.PLANT_SIZE
+            if i < self.plant_count:
+                self._wi(addr + Offset.P_ROW, i % 5)
+                self._wi(addr + Offset.P_COL, i % 9)
+                self._wi(addr + Offset.P_TYPE, i % 8)
+                self._wi(addr + Offset.P_HP, 300)
+                self._wi(addr + Offset.P_HP_MAX, 300)
+            else:
+                self.mem[addr + Offset.P_DEAD] = 1
+
+        for i in range(10):
+            addr = _SEED_ARRAY + i * Offset.SEED_SIZE
+            self._wi(addr + Offset.S_TYPE, i)
+            self._wi(addr + Offset.S_RECHARGE_TIME, 750)
+            self.mem[addr + Offset.S_USABLE] = 1
+
+    def tick(self, n: int = 1):
+        """Advance the synthetic game clock and move every zombie left"""
+        board = _BOARD
+        clock = self.read_int(board + Offset.GAME_CLOCK)
+        self._wi(board + Offset.GAME_CLOCK, clock + n)
+        for i in range(self.zombie_count):
+            addr = _ZOMBIE_ARRAY + i * Offset.ZOMBIE_SIZE
+            x = self.read_float(addr + Offset.Z_X)
+            self._wf(addr + Offset.Z_X, x - 0.23 * n)
+
+
+class MockHookServer:
+    """
+    Loopback hook-protocol server
+
+    Accepts one client and answers v1 text commands the way the DLL
+    bridge does (OK/ERR lines, HELLO negotiation), so HookClient
+    round-trip latency is measurable without an injected game.
+    """
+
+    def __init__(self, port: int = 0):
+        self._server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self._server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self._server.bind(('127.0.0.1', port))
+        self._server.listen(1)
+        self.port = self._server.getsockname()[1]
+        self._thread: Optional[threading.Thread] = None
+        self._running = False
+
+    def start(self):
+        """Start serving on a background thread"""
+        self._running = True
+        self._thread = threading.Thread(target=self._serve, daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        """Stop the server"""
+        self._running = False
+        try:
+            self._server.close()
+        except OSError:
+            pass
+
+    def _serve(self):
+        while self._running:
+            try:
+                client, _ = self._server.accept()
+            except OSError:
+                return
+            with client:
+                buf = b''
+                while self._running:
+                    try:
+                        data = client.recv(4096)
+                    except OSError:
+                        break
+                    if not data:
+                        break
+                    buf += data
+                    while b'\n' in buf:
+                        line, _, buf = buf.partition(b'\n')
+                        response = self._respond(line.decode('utf-8').strip())
+                        client.sendall(response.encode('utf-8'))
+
+    @staticmethod
+    def _respond(cmd: str) -> str:
+        parts = cmd.split()
+        if not parts:
+            return "ERR Empty\n"
+        if parts[0] == 'HELLO':
+            # Stay on v1 so benchmarks exercise the text path
+            return "OK 1 0\n"
+        if parts[0] in ('PLANT', 'SHOVEL', 'FIRE', 'RESET', 'CHOOSE',
+                        'ROCK', 'BACK', 'ENTER', 'PAUSE', 'RESUME'):
+            return "OK\n"
+        if parts[0] == 'COLLECT':
+            return "OK 0\n"
+        return "ERR Unknown command\n"
@@ -0,0 +1,222 @@
+"""
+Soak Harness
+End-to-end throughput and leak check for the full training stack
+
+Runs the real stack against a live injected game for a configurable
+duration: lockstep-steps through HookClient, resets the level at a
+fixed cadence, and reports steps/sec, p50/p99 step latency, reset
+latency, RSS growth of this Python process (catches the entity-object
+leak class) and reconnect counts. The JSON report is comparable
+across commits; pass a previous report via --baseline to gate on
+regressions (non-zero exit) before deploy instead of days later on
+the training-farm dashboards.
+
+Usage:
+    python -m bench.soak --live --duration 120 --output soak.json
+    python -m bench.soak --live --duration 120 --baseline soak.json
+"""
+
+import argparse
+import os
+import sys
+import time
+
+from bench.common import percentiles, emit_report
+from bench.bench_reset import measure_reset
+from hook_client.client import HookClient
+
+
+def _rss_mb() -> float:
+    """Current RSS of this Python process in MB"""
+    import psutil
+    return psutil.Process(os.getpid()).memory_info().rss / (1024 * 1024)
+
+
+def run_soak(client: HookClient, duration: float, ticks_per_step: int,
+             reset_every: float) -> dict:
+    """
+    Drive the step/reset loop for a fixed duration
+
+    Args:
+        client: Connected HookClient
+        duration: Seconds to run
+        ticks_per_step: Ticks advanced per lockstep step
+        reset_every: Seconds between level resets (0 disables)
+
+    Returns:
+        Soak result payload (see report fields)
+    """
+    step_samples = []
+    reset_samples = []
+    step_failures = 0
+    reset_failures = 0
+    rss_start = _rss_mb()
+    rss_peak = rss_start
+
+    client.pause()
+    start = time.perf_counter()
+    end = start + duration
+    next_reset = start + reset_every if reset_every > 0 else end + 1
+    next_rss = start + 5.0
+    steps = 0
+
+    while time.perf_counter() < end:
+        now = time.perf_counter()
+        if now >= next_reset:
+            # measure_reset waits for the game clock to advance and
+            # TicksToRun() returns 0 while paused — let it free-run
+            client.resume()
+            elapsed = measure_reset(client)
+            if elapsed < 0:
+                reset_failures += 1
+            else:
+                reset_samples.append(elapsed)
+            client.pause()
+            next_reset = now + reset_every
+            continue
+
+        t0 = time.perf_counter()
+        state = client.step(ticks_per_step)
+        if state is None:
+            step_failures += 1
+            # auto_reconnect brings the connection back in the
+            # background; don't spin at full speed meanwhile
+            time.sleep(0.05)
+            continue
+        step_samples.append((time.perf_counter() - t0) * 1000.0)
+        steps += 1
+
+        if now >= next_rss:
+            rss_peak = max(rss_peak, _rss_mb())
+            next_rss = now + 5.0
+
+    elapsed = time.perf_counter() - start
+    client.resume()
+    rss_end = _rss_mb()
+    health = client.health()
+
+    return {
+        'seconds': elapsed,
+        'steps': steps,
+        'ticks_per_step': ticks_per_step,
+        'steps_per_sec': steps / elapsed if elapsed > 0 else 0.0,
+        'step_latency': percentiles(step_samples),
+        'reset_latency': percentiles(reset_samples),
+        'step_failures': step_failures,
+        'reset_failures': reset_failures,
+        'reconnects': health['reconnects'],
+        'rss_start_mb': rss_start,
+        'rss_end_mb': rss_end,
+        'rss_peak_mb': max(rss_peak, rss_end),
+        'rss_growth_mb': rss_end - rss_start,
+    }
+
+
+def compare_to_baseline(current: dict, baseline: dict,
+                        tolerance: float) -> list:
+    """
+    Gate a soak result against a previous report's results
+
+    Args:
+        current: Result payload from this run
+        baseline: Result payload from the baseline report
+        tolerance: Allowed relative regression (e.g. 0.10 = 10%)
+
+    Returns:
+        List of human-readable regression descriptions (empty = pass)
+    """
+    regressions = []
+
+    base_rate = baseline.get('steps_per_sec', 0.0)
+    if base_rate > 0 and current['steps_per_sec'] < base_rate * (1 - tolerance):
+        regressions.append(
+            f"steps/sec {current['steps_per_sec']:.1f} < "
+            f"{base_rate:.1f} - {tolerance:.0%}")
+
+    base_p99 = baseline.get('step_latency', {}).get('p99_ms', 0.0)
+    cur_p99 = current['step_latency'].get('p99_ms', 0.0)
+    if base_p99 > 0 and cur_p99 > base_p99 * (1 + tolerance):
+        regressions.append(
+            f"step p99 {cur_p99:.2f}ms > {base_p99:.2f}ms + {tolerance:.0%}")
+
+    base_reset = baseline.get('reset_latency', {}).get('p50_ms', 0.0)
+    cur_reset = current['reset_latency'].get('p50_ms', 0.0)
+    if base_reset > 0 and cur_reset > base_reset * (1 + tolerance):
+        regressions.append(
+            f"reset p50 {cur_reset:.0f}ms > {base_reset:.0f}ms + {tolerance:.0%}")
+
+    # RSS growth is rate-like noise at small values; gate with a
+    # relative band plus a fixed floor so short runs don't flap
+    base_growth = baseline.get('rss_growth_mb', 0.0)
+    if current['rss_growth_mb'] > base_growth * (1 + tolerance) + 8.0:
+        regressions.append(
+            f"RSS growth {current['rss_growth_mb']:.1f}MB > "
+            f"{base_growth:.1f}MB + {tolerance:.0%} + 8MB")
+
+    if current['reconnects'] > baseline.get('reconnects', 0):
+        regressions.append(
+            f"reconnects {current['reconnects']} > "
+            f"{baseline.get('reconnects', 0)}")
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument('--duration', type=float, default=120.0,
+                        help='Seconds to soak')
+    parser.add_argument('--ticks', type=int, default=1,
+                        help='Ticks per lockstep step')
+    parser.add_argument('--reset-every', type=float, default=30.0,
+                        help='Seconds between level resets (0 disables)')
+    parser.add_argument('--live', action='store_true', required=True,
+                        help='Requires a live injected game')
+    parser.add_argument('--inject', action='store_true',
+                        help='Inject the hook DLL first')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=12345)
+    parser.add_argument('--tolerance', type=float, default=0.10,
+                        help='Allowed relative regression vs baseline')
+    parser.add_argument('--baseline', help='Previous soak report to gate against')
+    parser.add_argument('--output', help='Write JSON report to this file')
+    args = parser.parse_args()
+
+    if args.inject:
+        from hook_client.injector import inject_dll
+        if not inject_dll():
+            parser.error("DLL injection failed")
+        time.sleep(1.0)
+
+    client = HookClient(host=args.host, port=args.port,
+                        command_timeout=2.0, auto_reconnect=True)
+    if not client.connect():
+        parser.error("Failed to connect to hook server")
+
+    try:
+        results = run_soak(client, args.duration, args.ticks,
+                           args.reset_every)
+    finally:
+        client.close()
+
+    emit_report('soak',
+                {'duration': args.duration, 'ticks': args.ticks,
+                 'reset_every': args.reset_every,
+                 'tolerance': args.tolerance},
+                results, args.output)
+
+    if args.baseline:
+        import json
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare_to_baseline(
+            results, baseline.get('results', {}), args.tolerance)
+        if regressions:
+            print("REGRESSIONS vs baseline:")
+            for line in regressions:
+                print(f"  - {line}")
+            sys.exit(1)
+        print("No regressions vs baseline")
+
+
+if __name__ == '__main__':
+    main()
@@ -44,6 +44,13 @@ class BotConfig:
     
     # Log to file path (None = console only)
     log_file: Optional[str] = None
+
+    # Route log_status through the preallocated ring buffer with a
+    # background drainer (cheap enough for a per-tick monitor loop)
+    fast_status: bool = False
+
+    # How often the drainer renders the newest status record (seconds)
+    status_drain_interval: float = 1.0
     
     # ========================================================================
     # Economy Settings
@@ -15,6 +15,7 @@ from game.state import GameState, SeedInfo
 from game.zombie import ZombieInfo
 from game.plant import PlantInfo
 from game.grid import Grid
+from game.wave_timeline import WaveTimeline
 
 from data.offsets import Offset
 from data.plants import get_unlocked_plants
@@ -49,6 +50,9 @@ class PVZInterface:
         """
         self.mode = mode
         self.logger = get_logger()
+        # Per-board wave timeline cache (spawn lists are level-static)
+        self._wave_timeline: Optional[WaveTimeline] = None
+        self._wave_timeline_board = 0
         
         if mode == InterfaceMode.HOOK:
             self._init_hook_mode()
@@ -258,6 +262,11 @@ class PVZInterface:
         
         # Read spawn lists
         spawn_lists = self._read_spawn_lists(board, total_waves)
+
+        # Wave timeline is derived once per board and shared by reference
+        if self._wave_timeline is None or self._wave_timeline_board != board:
+            self._wave_timeline = WaveTimeline(spawn_lists)
+            self._wave_timeline_board = board
         
         return GameState(
             sun=sun,
@@ -276,6 +285,7 @@ class PVZInterface:
             player_coins=player_coins,
             unlocked_plants=unlocked_plants,
             spawn_lists=spawn_lists,
+            wave_timeline=self._wave_timeline,
         )
     
     def _read_zombies(self, board: int) -> list:
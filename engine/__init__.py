@@ -3,4 +3,7 @@ Engine Module
 Provides action definitions for the LLM player
 """
 
-from engine.action import Action, ActionType
+from engine.action import Action, ActionType, ActionScheduler
+
+# VectorPVZEnv is imported lazily from engine.vector_env to avoid pulling
+# hook_client (psutil, Windows-only injection) into single-process users
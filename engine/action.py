@@ -5,7 +5,7 @@ Defines all possible actions the bot can take
 
 from dataclasses import dataclass, field
 from enum import IntEnum, auto
-from typing import Optional, Dict, Any
+from typing import Any, Dict, List, Optional, Tuple
 
 
 class ActionType(IntEnum):
@@ -199,3 +199,162 @@ class Action:
             return f"Action(COB at x={self.target_x:.0f}, row={self.row}, priority={self.priority:.1f})"
         else:
             return f"Action({self.type_name} at ({self.row}, {self.col}), priority={self.priority:.1f})"
+
+
+class ActionScheduler:
+    """
+    Priority queue of pending actions with budgeted batch dispatch
+
+    Planners submit Actions as they are decided; once per tick
+    dispatch() coalesces duplicates targeting the same cell, orders by
+    priority, validates each action against the current GameState (sun
+    budget, seed cooldowns, cell occupancy) and sends the affordable
+    subset in one batch. Actions that would fail in-game are filtered
+    client-side instead of each costing a round trip to be rejected.
+
+    Actions short on sun or waiting out a cooldown stay queued for a
+    later tick (up to `ttl` dispatches); actions that are structurally
+    impossible right now (no such seed in the deck, target cell
+    occupied, nothing to shovel) are dropped.
+    """
+
+    def __init__(self, client, ttl: int = 100):
+        """
+        Initialize scheduler
+
+        Args:
+            client: Dispatch target. A HookClient (uses execute_batch
+                    for single-round-trip dispatch) or any object with
+                    plant/shovel/fire_cob/collect methods
+            ttl: Dispatch attempts an action may sit in the queue
+                 before being dropped as stale
+        """
+        self.client = client
+        self.ttl = ttl
+        # Keyed by coalesce key so duplicate plans merge on submit
+        self._pending: Dict[Tuple, List] = {}
+
+    @staticmethod
+    def _key(action: Action) -> Tuple:
+        """Coalesce key: two plans for the same cell merge into one"""
+        if action.action_type == ActionType.USE_COB:
+            return (action.action_type, action.row, int(action.target_x))
+        return (action.action_type, action.row, action.col)
+
+    def submit(self, action: Action):
+        """
+        Queue an action for the next dispatch
+
+        A duplicate of an already-queued action (same type and target
+        cell) keeps whichever has the higher priority.
+        """
+        if action.is_wait:
+            return
+        key = self._key(action)
+        entry = self._pending.get(key)
+        if entry is None or action.priority > entry[0].priority:
+            self._pending[key] = [action, 0]
+
+    def submit_all(self, actions: List[Action]):
+        """Queue several actions"""
+        for action in actions:
+            self.submit(action)
+
+    @property
+    def pending_count(self) -> int:
+        """Number of queued actions"""
+        return len(self._pending)
+
+    def clear(self):
+        """Drop all queued actions"""
+        self._pending.clear()
+
+    def dispatch(self, state) -> List[Tuple[Action, bool]]:
+        """
+        Validate, budget and dispatch queued actions as one batch
+
+        Args:
+            state: Current GameState snapshot
+
+        Returns:
+            List of (action, success) for every action sent this tick
+        """
+        if not self._pending:
+            return []
+
+        ordered = sorted(self._pending.values(),
+                         key=lambda entry: entry[0].priority, reverse=True)
+
+        accepted: List[Action] = []
+        commands: List[str] = []
+        sun_left = state.sun
+        # Seeds spent this tick: planting starts the cooldown, so a
+        # second action on the same card must wait
+        used_seeds = set()
+
+        for entry in ordered:
+            action = entry[0]
+            keep = False
+
+            if action.is_plant_action:
+                seed = state.get_seed_by_type(action.plant_type)
+                if seed is None:
+                    pass  # Not in the deck: drop
+                elif not state.is_cell_empty(action.row, action.col):
+                    pass  # Cell occupied: the plan is stale, drop
+                elif (not seed.is_ready or action.plant_type in used_seeds or
+                      action.sun_cost > sun_left):
+                    keep = True  # Affordable later: cooldown or sun
+                else:
+                    sun_left -= action.sun_cost
+                    used_seeds.add(action.plant_type)
+                    accepted.append(action)
+                    commands.append(
+                        f"PLANT {action.row} {action.col} {action.plant_type}")
+            elif action.action_type == ActionType.SHOVEL:
+                if state.get_plant_at(action.row, action.col) is not None:
+                    accepted.append(action)
+                    commands.append(f"SHOVEL {action.row} {action.col}")
+            elif action.action_type == ActionType.USE_COB:
+                if state.can_fire_cob():
+                    accepted.append(action)
+                    commands.append(
+                        f"FIRE {int(action.target_x)} {int(action.target_y)}")
+                else:
+                    keep = True  # Cobs reloading
+            elif action.action_type == ActionType.COLLECT_SUN:
+                accepted.append(action)
+                commands.append("COLLECT")
+
+            if keep:
+                entry[1] += 1
+                if entry[1] >= self.ttl:
+                    keep = False
+            if not keep:
+                self._pending.pop(self._key(action), None)
+
+        if not commands:
+            return []
+
+        if hasattr(self.client, 'execute_batch'):
+            # One round trip; the hook runs all commands in the same
+            # game frame
+            results = self.client.execute_batch(commands)
+        else:
+            results = [self._dispatch_single(a) for a in accepted]
+
+        return list(zip(accepted, results))
+
+    def _dispatch_single(self, action: Action) -> bool:
+        """Fallback path for clients without batch support"""
+        if action.is_plant_action:
+            return bool(self.client.plant(
+                action.row, action.col, action.plant_type))
+        if action.action_type == ActionType.SHOVEL:
+            return bool(self.client.shovel(action.row, action.col))
+        if action.action_type == ActionType.USE_COB:
+            return bool(self.client.fire_cob(
+                int(action.target_x), int(action.target_y)))
+        if action.action_type == ActionType.COLLECT_SUN:
+            return bool(self.client.collect())
+        return False
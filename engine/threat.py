@@ -0,0 +1,176 @@
+"""
+Threat Analytics Engine
+Vectorized all-rows threat analysis over zombie feature arrays
+"""
+
+from typing import Optional
+
+from game.state import GameState, OBS_ROWS, ZOMBIE_FEATURES
+
+# Column indexes into the Nx16 zombie feature matrix
+_ROW = ZOMBIE_FEATURES.index('row')
+_X = ZOMBIE_FEATURES.index('x')
+_TYPE = ZOMBIE_FEATURES.index('type')
+_HP = ZOMBIE_FEATURES.index('hp')
+_ACCESSORY_HP = ZOMBIE_FEATURES.index('accessory_hp')
+_SPEED = ZOMBIE_FEATURES.index('speed')
+_SLOW = ZOMBIE_FEATURES.index('slow_countdown')
+_FREEZE = ZOMBIE_FEATURES.index('freeze_countdown')
+_BUTTER = ZOMBIE_FEATURES.index('butter_countdown')
+
+# X position where a zombie has effectively entered the house
+# (matches the IsZombieInHouse threshold in hook/src/game.cpp)
+HOUSE_X = 50.0
+
+# Type -> threat multiplier lookup, built once from data.zombies
+_TYPE_TABLE_SIZE = 64
+_threat_multipliers = None
+_dangerous_types = None
+
+
+def _type_tables():
+    """Build (and cache) vectorized lookups for per-type zombie data"""
+    global _threat_multipliers, _dangerous_types
+    if _threat_multipliers is None:
+        import numpy as np
+        from data.zombies import get_threat_multiplier, is_dangerous_zombie
+        mult = np.ones(_TYPE_TABLE_SIZE, dtype=np.float32)
+        danger = np.zeros(_TYPE_TABLE_SIZE, dtype=bool)
+        for t in range(_TYPE_TABLE_SIZE):
+            mult[t] = get_threat_multiplier(t)
+            danger[t] = is_dangerous_zombie(t)
+        _threat_multipliers = mult
+        _dangerous_types = danger
+    return _threat_multipliers, _dangerous_types
+
+
+class ThreatMap:
+    """
+    All-rows threat summary computed in one vectorized pass
+
+    Mirrors the scalar formulas of ZombieInfo.threat_level and
+    time_to_reach(), but evaluates every zombie at once and buckets
+    the results per row. The decision loop reads whole-board answers
+    (threat vector, leading zombie, time-to-house) without walking
+    Python property chains per zombie per row.
+    """
+
+    def __init__(self, zombies, zombie_count: Optional[int] = None,
+                 num_rows: int = OBS_ROWS):
+        """
+        Build the threat map
+
+        Args:
+            zombies: Nx16 zombie feature matrix (ZOMBIE_FEATURES columns),
+                     e.g. the 'zombies' array from to_arrays()
+            zombie_count: Number of valid leading rows in the matrix
+                          (rest is padding); all rows when omitted
+            num_rows: Number of lawn rows to report
+        """
+        import numpy as np
+
+        self.num_rows = num_rows
+        z = np.asarray(zombies, dtype=np.float32)
+        if zombie_count is not None:
+            z = z[:zombie_count]
+        z = z[z[:, _HP] > 0]
+
+        rows = z[:, _ROW].astype(np.int32)
+        valid = (rows >= 0) & (rows < num_rows)
+        z = z[valid]
+        rows = rows[valid]
+
+        # Per-row outputs
+        self.row_threat = np.zeros(num_rows, dtype=np.float32)
+        self.row_counts = np.zeros(num_rows, dtype=np.int32)
+        self.dangerous_counts = np.zeros(num_rows, dtype=np.int32)
+        self.leading_x = np.full(num_rows, np.inf, dtype=np.float32)
+        self.time_to_house = np.full(num_rows, np.inf, dtype=np.float32)
+
+        if len(z) == 0:
+            return
+
+        x = z[:, _X]
+        types = np.clip(z[:, _TYPE].astype(np.int32), 0, _TYPE_TABLE_SIZE - 1)
+        mult_table, danger_table = _type_tables()
+
+        # Effective speed: frozen/buttered zombies stand still, slowed at half
+        immobile = (z[:, _FREEZE] > 0) | (z[:, _BUTTER] > 0)
+        eff_speed = np.where(z[:, _SLOW] > 0, z[:, _SPEED] * 0.5, z[:, _SPEED])
+        eff_speed = np.where(immobile, 0.0, eff_speed)
+
+        # Same formula as ZombieInfo.threat_level, vectorized
+        distance_threat = np.clip((800.0 - x) / 800.0, 0.0, None)
+        hp_threat = np.minimum(1.0, (z[:, _HP] + z[:, _ACCESSORY_HP]) / 3000.0)
+        speed_mult = 1.0 + np.abs(eff_speed) * 0.5
+        threat = distance_threat * (1.0 + hp_threat) * mult_table[types] * speed_mult
+        threat = np.where(x < 200.0, threat * 1.5, threat)
+
+        # Same semantics as ZombieInfo.time_to_reach(HOUSE_X)
+        distance = x - HOUSE_X
+        moving = np.abs(eff_speed) > 0
+        tth = np.full(len(z), np.inf, dtype=np.float32)
+        np.divide(distance, np.abs(eff_speed), out=tth, where=moving)
+        tth = np.where(distance <= 0, 0.0, tth)
+
+        np.add.at(self.row_threat, rows, threat)
+        np.add.at(self.row_counts, rows, 1)
+        np.add.at(self.dangerous_counts, rows, danger_table[types].astype(np.int32))
+        np.minimum.at(self.leading_x, rows, x)
+        np.minimum.at(self.time_to_house, rows, tth)
+
+    @classmethod
+    def from_state(cls, state: GameState, num_rows: Optional[int] = None) -> 'ThreatMap':
+        """
+        Build a ThreatMap from a GameState snapshot
+
+        Args:
+            state: Game state snapshot
+            num_rows: Lawn row count (default: derived from the scene)
+
+        Returns:
+            ThreatMap over the snapshot's zombies
+        """
+        import numpy as np
+        if num_rows is None:
+            from data.offsets import SceneType
+            num_rows = SceneType.get_row_count(state.scene)
+        zombies = state.alive_zombies
+        z = np.zeros((len(zombies), len(ZOMBIE_FEATURES)), dtype=np.float32)
+        for i, zombie in enumerate(zombies):
+            for k, feature in enumerate(ZOMBIE_FEATURES):
+                z[i, k] = float(getattr(zombie, feature))
+        return cls(z, num_rows=num_rows)
+
+    @classmethod
+    def from_arrays(cls, out: dict, num_rows: int = OBS_ROWS) -> 'ThreatMap':
+        """
+        Build a ThreatMap from an observation buffer dict
+
+        Args:
+            out: Buffer dict from to_arrays()/read_state_arrays()
+            num_rows: Lawn row count
+
+        Returns:
+            ThreatMap over the buffer's zombie matrix
+        """
+        return cls(out['zombies'], zombie_count=out.get('zombie_count'),
+                   num_rows=num_rows)
+
+    def most_threatened_row(self) -> int:
+        """Row index with the highest total threat"""
+        import numpy as np
+        return int(np.argmax(self.row_threat))
+
+    def rows_by_urgency(self):
+        """Row indexes sorted by time-to-house, most urgent first"""
+        import numpy as np
+        return np.argsort(self.time_to_house, kind='stable')
+
+    def total_threat(self) -> float:
+        """Total threat over the whole board"""
+        return float(self.row_threat.sum())
+
+    def __repr__(self) -> str:
+        threat = ', '.join(f"{t:.1f}" for t in self.row_threat)
+        return f"ThreatMap(rows=[{threat}], zombies={int(self.row_counts.sum())})"
@@ -0,0 +1,216 @@
+"""
+Vectorized Environment
+Manages multiple PVZ game processes for parallel training
+"""
+
+import ctypes
+import logging
+from concurrent.futures import ThreadPoolExecutor
+from typing import Callable, List, Optional
+
+from engine.action import Action, ActionType
+from game.reader import GameReader
+from game.state import GameState
+from memory.reader import MemoryReader
+from hook_client.client import HookClient
+from hook_client.injector import inject_all, find_all_pvz_processes
+
+logger = logging.getLogger(__name__)
+
+# Hook DLL scans forward from this port, one per game process
+BASE_PORT = 12345
+MAX_INSTANCES = 32
+
+PROCESS_ALL_ACCESS = 0x1F0FFF
+
+
+class PVZInstance:
+    """
+    Handle to a single game process
+
+    Pairs a GameReader (bulk memory reads for state) with a HookClient
+    (command execution), the same split PVZMemoryInterface uses for a
+    single process.
+    """
+
+    def __init__(self, index: int, pid: int, port: int):
+        self.index = index
+        self.pid = pid
+        self.port = port
+        # Reconnect in the background so one crashed game does not stall
+        # the whole batch; health() reports instances to mask out
+        self.client = HookClient(port=port, auto_reconnect=True)
+        self.reader: Optional[GameReader] = None
+        self._handle: Optional[int] = None
+
+    def attach(self) -> bool:
+        """Open the process for memory reading and connect the hook client"""
+        kernel32 = ctypes.windll.kernel32
+        handle = kernel32.OpenProcess(PROCESS_ALL_ACCESS, False, self.pid)
+        if not handle:
+            logger.error(f"Failed to open process {self.pid}")
+            return False
+        self._handle = handle
+        self.reader = GameReader(MemoryReader(kernel32, handle))
+        return self.client.connect()
+
+    def close(self):
+        """Disconnect and release the process handle"""
+        self.client.close()
+        if self._handle:
+            ctypes.windll.kernel32.CloseHandle(self._handle)
+            self._handle = None
+        self.reader = None
+
+    def read_state(self) -> GameState:
+        """Read this instance's full game state"""
+        if self.reader is None:
+            return GameState()
+        return self.reader.read_game_state()
+
+    def apply_action(self, action: Optional[Action]) -> bool:
+        """Execute one Action through the hook client"""
+        if action is None or action.action_type == ActionType.WAIT:
+            return True
+        if action.action_type == ActionType.PLANT:
+            return self.client.plant(action.row, action.col, action.plant_type)
+        if action.action_type == ActionType.SHOVEL:
+            return self.client.shovel(action.row, action.col)
+        if action.action_type == ActionType.USE_COB:
+            return self.client.fire_cob(int(action.target_x), int(action.target_y))
+        if action.action_type in (ActionType.USE_CHERRY, ActionType.USE_JALAPENO,
+                                  ActionType.USE_ICE, ActionType.USE_DOOM,
+                                  ActionType.USE_SQUASH):
+            # Instants are planted like any other seed
+            return self.client.plant(action.row, action.col, action.plant_type)
+        logger.warning(f"Unsupported action type: {action.action_type}")
+        return False
+
+
+class VectorPVZEnv:
+    """
+    Batched interface over N game processes
+
+    Discovers running PVZ processes, injects the hook DLL into each
+    (every DLL binds its own port in [BASE_PORT, BASE_PORT+32)), and
+    fans batched operations out over a thread pool. All per-instance
+    work is I/O-bound (ReadProcessMemory / socket waits), so threads
+    scale to 16-32 instances without the GIL becoming the bottleneck.
+    """
+
+    def __init__(self, num_envs: int, dll_path: Optional[str] = None,
+                 base_port: int = BASE_PORT, max_workers: Optional[int] = None):
+        """
+        Initialize the environment manager
+
+        Args:
+            num_envs: Number of game instances to manage
+            dll_path: Hook DLL path (default: hook/pvz_hook.dll)
+            base_port: First port of the hook DLL scan range
+            max_workers: Thread pool size (default: num_envs)
+        """
+        if num_envs > MAX_INSTANCES:
+            raise ValueError(f"num_envs must be <= {MAX_INSTANCES}")
+        self.num_envs = num_envs
+        self.dll_path = dll_path
+        self.base_port = base_port
+        self.instances: List[PVZInstance] = []
+        self._pool = ThreadPoolExecutor(max_workers=max_workers or num_envs)
+
+    def launch(self) -> int:
+        """
+        Discover, inject and attach up to num_envs game processes
+
+        Returns:
+            Number of instances successfully attached
+        """
+        pids = find_all_pvz_processes(refresh=True)
+        if not pids:
+            logger.error("No PVZ processes found")
+            return 0
+
+        # Inject all discovered processes in parallel; each DLL picks its
+        # own free port. Bring-up cost is the slowest single injection.
+        results = inject_all(pids[:self.num_envs], dll_path=self.dll_path,
+                             max_parallel=self.num_envs)
+        for pid, ok in results.items():
+            if not ok:
+                logger.warning(f"Injection failed for pid {pid}")
+
+        # Map ports back to pids via the HELLO response
+        wanted = set(pids[:self.num_envs])
+        for port in range(self.base_port, self.base_port + MAX_INSTANCES):
+            if len(self.instances) >= self.num_envs:
+                break
+            client = HookClient(port=port, timeout=1.0)
+            if not client.connect():
+                continue
+            pid = client.server_pid
+            client.disconnect()
+            if pid is None or pid not in wanted:
+                continue
+            wanted.discard(pid)
+            instance = PVZInstance(len(self.instances), pid, port)
+            if instance.attach():
+                self.instances.append(instance)
+            else:
+                instance.close()
+
+        logger.info(f"VectorPVZEnv attached {len(self.instances)}/{self.num_envs} instances")
+        return len(self.instances)
+
+    def _map(self, fn: Callable[[PVZInstance], object], *arg_lists) -> list:
+        """Run fn over all instances in the thread pool, preserving order"""
+        return list(self._pool.map(fn, self.instances, *arg_lists))
+
+    def get_states(self) -> List[GameState]:
+        """Read all instances' game states in parallel"""
+        return self._map(PVZInstance.read_state)
+
+    def apply_actions(self, actions: List[Optional[Action]]) -> List[bool]:
+        """
+        Execute one action per instance in parallel
+
+        Args:
+            actions: One Action (or None/WAIT) per instance
+
+        Returns:
+            Per-instance success flags
+        """
+        if len(actions) != len(self.instances):
+            raise ValueError(
+                f"Expected {len(self.instances)} actions, got {len(actions)}")
+        return self._map(PVZInstance.apply_action, actions)
+
+    def step(self, n_ticks: int = 1) -> List[Optional[dict]]:
+        """Lockstep-advance all instances and return their post-step states"""
+        return self._map(lambda inst: inst.client.step(n_ticks))
+
+    def reset(self) -> List[bool]:
+        """Reset all instances' levels in parallel"""
+        return self._map(lambda inst: inst.client.reset())
+
+    def health(self) -> List[dict]:
+        """
+        Per-instance connection health
+
+        Training loops use this to mask out dead or reconnecting
+        instances instead of blocking the batch on their timeouts.
+        """
+        return [inst.client.health() for inst in self.instances]
+
+    def close(self):
+        """Release all instances and the thread pool"""
+        for instance in self.instances:
+            instance.close()
+        self.instances = []
+        self._pool.shutdown(wait=False)
+
+    def __enter__(self) -> 'VectorPVZEnv':
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
+
+    def __len__(self) -> int:
+        return len(self.instances)
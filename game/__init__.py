@@ -10,4 +10,5 @@ from game.grid import Grid
 from game.projectile import ProjectileInfo, ProjectileType
 from game.lawnmower import LawnmowerInfo, LawnMowerState, LawnMowerType
 from game.place_item import PlaceItemInfo, PlaceItemType
+from game.wave_timeline import WaveTimeline, WaveInfo
 from game.reader import GameReader
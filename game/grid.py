@@ -6,92 +6,295 @@ Represents the game grid for quick plant lookup
 from typing import Optional, List, Dict, Tuple
 from dataclasses import dataclass, field
 
+from data.constants import GridSquareType
+from data.plants import (
+    PlantType, AQUATIC_PLANTS, MUSHROOM_PLANTS, UPGRADE_PLANTS,
+)
+
+# Cells a pumpkin/coffee bean sit on top of are tracked as separate
+# layers, mirroring how the game keeps them as distinct Plant objects
+# at the same grid square
+_CARRIER_TYPES = (int(PlantType.LILYPAD), int(PlantType.FLOWERPOT))
+
+FULL_ROW_MASK = (1 << 9) - 1
+
 
 @dataclass
 class Grid:
     """
-    Grid representation for quick plant lookup
-    
+    Spatial index over the game grid
+
     Standard PVZ grid is 9 columns x 6 rows (pool levels)
-    or 9 columns x 5 rows (day/night/roof levels)
+    or 9 columns x 5 rows (day/night/roof levels).
+
+    Beyond positional plant lookup, the grid keeps per-row occupancy
+    bitmasks (bit c = column c occupied) maintained incrementally on
+    set/clear, and combines them with terrain from read_grid_types()
+    to answer "where can plant X go" with a few bitwise ops per row
+    instead of 54 get_plant_at/get_grid_type round trips.
+
+    Stacking is modelled as layers, matching the game's own object
+    model: carriers (lily pad / flower pot) below the base plant,
+    pumpkin shells and coffee beans above it. get() returns the most
+    relevant plant at a cell (base, then carrier, then shell).
     """
-    
+
     rows: int = 6
     cols: int = 9
     _grid: Dict[Tuple[int, int], any] = field(default_factory=dict)
-    
+    _carriers: Dict[Tuple[int, int], any] = field(default_factory=dict)
+    _pumpkins: Dict[Tuple[int, int], any] = field(default_factory=dict)
+    _coffee: Dict[Tuple[int, int], any] = field(default_factory=dict)
+
+    def __post_init__(self):
+        # Per-layer occupancy bitmasks, one int per row
+        self._row_masks = [0] * self.rows
+        self._carrier_masks = [0] * self.rows
+        self._pumpkin_masks = [0] * self.rows
+        self._coffee_masks = [0] * self.rows
+        # Terrain masks default to all-grass until set_grid_types()
+        self._ground_masks = [FULL_ROW_MASK] * self.rows
+        self._pool_masks = [0] * self.rows
+        self._roof_masks = [0] * self.rows
+
+    def _in_bounds(self, row: int, col: int) -> bool:
+        return 0 <= row < self.rows and 0 <= col < self.cols
+
     def set(self, row: int, col: int, plant) -> None:
-        """Set a plant at a grid position"""
-        if 0 <= row < self.rows and 0 <= col < self.cols:
+        """Set a plant at a grid position (routed to its stacking layer)"""
+        if not self._in_bounds(row, col):
+            return
+        bit = 1 << col
+        ptype = int(getattr(plant, 'type', -1))
+        if ptype == PlantType.PUMPKIN:
+            self._pumpkins[(row, col)] = plant
+            self._pumpkin_masks[row] |= bit
+        elif ptype == PlantType.COFFEEBEAN:
+            self._coffee[(row, col)] = plant
+            self._coffee_masks[row] |= bit
+        elif ptype in _CARRIER_TYPES:
+            self._carriers[(row, col)] = plant
+            self._carrier_masks[row] |= bit
+        else:
             self._grid[(row, col)] = plant
-    
+            self._row_masks[row] |= bit
+
     def get(self, row: int, col: int) -> Optional[any]:
-        """Get plant at a grid position"""
-        return self._grid.get((row, col), None)
-    
+        """Get plant at a grid position (base, then carrier, then shell)"""
+        key = (row, col)
+        return (self._grid.get(key) or self._carriers.get(key)
+                or self._pumpkins.get(key) or self._coffee.get(key))
+
     def clear(self, row: int, col: int) -> None:
-        """Clear a grid position"""
-        if (row, col) in self._grid:
-            del self._grid[(row, col)]
-    
+        """Clear all layers at a grid position"""
+        if not self._in_bounds(row, col):
+            return
+        key = (row, col)
+        keep = ~(1 << col)
+        if self._grid.pop(key, None) is not None:
+            self._row_masks[row] &= keep
+        if self._carriers.pop(key, None) is not None:
+            self._carrier_masks[row] &= keep
+        if self._pumpkins.pop(key, None) is not None:
+            self._pumpkin_masks[row] &= keep
+        if self._coffee.pop(key, None) is not None:
+            self._coffee_masks[row] &= keep
+
     def is_empty(self, row: int, col: int) -> bool:
-        """Check if a grid position is empty"""
-        return self.get(row, col) is None
-    
+        """Check if a grid position has no base plant (carriers don't count)"""
+        return (row, col) not in self._grid
+
+    def has_pumpkin(self, row: int, col: int) -> bool:
+        """Check if a grid position has a pumpkin shell"""
+        return (row, col) in self._pumpkins
+
+    def has_coffee_bean(self, row: int, col: int) -> bool:
+        """Check if a grid position has a coffee bean"""
+        return (row, col) in self._coffee
+
+    def get_carrier(self, row: int, col: int) -> Optional[any]:
+        """Get the lily pad / flower pot at a grid position"""
+        return self._carriers.get((row, col))
+
+    def row_mask(self, row: int) -> int:
+        """Base-layer occupancy bitmask for a row (bit c = column c occupied)"""
+        if 0 <= row < self.rows:
+            return self._row_masks[row]
+        return 0
+
+    # ========================================================================
+    # Terrain / plantability
+    # ========================================================================
+
+    def set_grid_types(self, grid_types: List[List[int]]) -> None:
+        """
+        Attach terrain from GameReader.read_grid_types()
+
+        Precomputes per-row ground/pool/roof masks so plantability
+        queries are pure bit arithmetic.
+        """
+        if not grid_types:
+            return
+        for row in range(min(self.rows, len(grid_types))):
+            ground = pool = roof = 0
+            for col in range(min(self.cols, len(grid_types[row]))):
+                bit = 1 << col
+                square = grid_types[row][col]
+                if square == GridSquareType.GRASS:
+                    ground |= bit
+                elif square == GridSquareType.POOL:
+                    pool |= bit
+                elif square == GridSquareType.HIGH_GROUND:
+                    roof |= bit
+            self._ground_masks[row] = ground
+            self._pool_masks[row] = pool
+            self._roof_masks[row] = roof
+
+    def _base_type_mask(self, row: int, plant_types) -> int:
+        """Bitmask of cells in a row whose base plant has one of the types"""
+        mask = 0
+        for (r, c), plant in self._grid.items():
+            if r == row and int(getattr(plant, 'type', -1)) in plant_types:
+                mask |= 1 << c
+        return mask
+
+    def plantable_mask(self, row: int, plant_type: int) -> int:
+        """
+        Bitmask of cells in a row where plant_type can be placed
+
+        Understands terrain (non-aquatic plants need a lily pad in the
+        pool and a flower pot on the roof), pumpkin/coffee stacking
+        and upgrade-plant base requirements. Sun cost and seed
+        cooldown are the caller's problem.
+        """
+        if not 0 <= row < self.rows:
+            return 0
+        plant_type = int(plant_type)
+        occupied = self._row_masks[row]
+        carriers = self._carrier_masks[row]
+        ground = self._ground_masks[row]
+        pool = self._pool_masks[row]
+        roof = self._roof_masks[row]
+
+        if plant_type == PlantType.PUMPKIN:
+            # Over any empty or occupied land/carrier cell without one
+            return (ground | carriers) & ~self._pumpkin_masks[row]
+        if plant_type == PlantType.COFFEEBEAN:
+            # Only on a sleeping mushroom without a bean already
+            mushrooms = self._base_type_mask(row, MUSHROOM_PLANTS)
+            return mushrooms & ~self._coffee_masks[row]
+        if plant_type in UPGRADE_PLANTS:
+            if plant_type == PlantType.CATTAIL:
+                # Cattail upgrades the carrier layer, not the base plant
+                return carriers & pool & ~occupied
+            base = int(UPGRADE_PLANTS[PlantType(plant_type)])
+            return self._base_type_mask(row, (base,))
+        if plant_type == PlantType.LILYPAD:
+            return pool & ~carriers & ~occupied
+        if plant_type == PlantType.FLOWERPOT:
+            return (roof | ground) & ~carriers & ~occupied
+        if plant_type in AQUATIC_PLANTS:
+            # Tangle kelp / sea-shroom sit in open water
+            return pool & ~carriers & ~occupied
+        # Regular plant: open ground, or an unoccupied lily pad / pot
+        return (ground | carriers) & ~occupied
+
+    def is_plantable(self, row: int, col: int, plant_type: int) -> bool:
+        """Check if plant_type can be placed at a grid position"""
+        if not self._in_bounds(row, col):
+            return False
+        return bool(self.plantable_mask(row, plant_type) & (1 << col))
+
+    def get_plantable_cells(self, plant_type: int) -> List[Tuple[int, int]]:
+        """Get all positions where plant_type can currently be placed"""
+        cells = []
+        for row in range(self.rows):
+            mask = self.plantable_mask(row, plant_type)
+            while mask:
+                low = mask & -mask
+                cells.append((row, low.bit_length() - 1))
+                mask ^= low
+        return cells
+
+    # ========================================================================
+    # Aggregate queries
+    # ========================================================================
+
+    def _layers(self):
+        return (self._grid, self._carriers, self._pumpkins, self._coffee)
+
     def get_row(self, row: int) -> List[any]:
-        """Get all plants in a row"""
-        return [self._grid[(row, col)] for col in range(self.cols) 
-                if (row, col) in self._grid]
-    
+        """Get all plants in a row (every stacking layer)"""
+        return [layer[(row, col)] for col in range(self.cols)
+                for layer in self._layers() if (row, col) in layer]
+
     def get_col(self, col: int) -> List[any]:
-        """Get all plants in a column"""
-        return [self._grid[(row, col)] for row in range(self.rows) 
-                if (row, col) in self._grid]
-    
+        """Get all plants in a column (every stacking layer)"""
+        return [layer[(row, col)] for row in range(self.rows)
+                for layer in self._layers() if (row, col) in layer]
+
     def get_all_plants(self) -> List[any]:
-        """Get all plants in the grid"""
-        return list(self._grid.values())
-    
+        """Get all plants in the grid (every stacking layer)"""
+        plants = []
+        for layer in self._layers():
+            plants.extend(layer.values())
+        return plants
+
     def get_empty_positions(self) -> List[Tuple[int, int]]:
-        """Get all empty grid positions"""
+        """Get all grid positions without a base plant"""
         return [(row, col) for row in range(self.rows) for col in range(self.cols)
                 if (row, col) not in self._grid]
-    
+
     def get_occupied_positions(self) -> List[Tuple[int, int]]:
-        """Get all occupied grid positions"""
+        """Get all grid positions with a base plant"""
         return list(self._grid.keys())
-    
+
     def count(self) -> int:
-        """Get total number of plants in grid"""
-        return len(self._grid)
-    
+        """Get total number of plants in grid (every stacking layer)"""
+        return sum(len(layer) for layer in self._layers())
+
     def count_in_row(self, row: int) -> int:
-        """Count plants in a specific row"""
-        return sum(1 for r, c in self._grid.keys() if r == row)
-    
+        """Count base plants in a specific row"""
+        return bin(self.row_mask(row)).count('1')
+
     def count_in_col(self, col: int) -> int:
-        """Count plants in a specific column"""
+        """Count base plants in a specific column"""
         return sum(1 for r, c in self._grid.keys() if c == col)
-    
+
     def clear_all(self) -> None:
-        """Clear the entire grid"""
-        self._grid.clear()
-    
+        """Clear the entire grid (terrain masks are kept)"""
+        for layer in self._layers():
+            layer.clear()
+        self._row_masks = [0] * self.rows
+        self._carrier_masks = [0] * self.rows
+        self._pumpkin_masks = [0] * self.rows
+        self._coffee_masks = [0] * self.rows
+
     def copy(self) -> 'Grid':
         """Create a copy of the grid"""
         new_grid = Grid(self.rows, self.cols)
         new_grid._grid = self._grid.copy()
+        new_grid._carriers = self._carriers.copy()
+        new_grid._pumpkins = self._pumpkins.copy()
+        new_grid._coffee = self._coffee.copy()
+        new_grid._row_masks = list(self._row_masks)
+        new_grid._carrier_masks = list(self._carrier_masks)
+        new_grid._pumpkin_masks = list(self._pumpkin_masks)
+        new_grid._coffee_masks = list(self._coffee_masks)
+        new_grid._ground_masks = list(self._ground_masks)
+        new_grid._pool_masks = list(self._pool_masks)
+        new_grid._roof_masks = list(self._roof_masks)
         return new_grid
-    
+
     def __repr__(self) -> str:
         return f"Grid({self.rows}x{self.cols}, {self.count()} plants)"
-    
+
     def visualize(self) -> str:
         """Create a text visualization of the grid"""
         lines = []
         lines.append("  " + " ".join(str(c) for c in range(self.cols)))
         lines.append("  " + "-" * (self.cols * 2 - 1))
-        
+
         for row in range(self.rows):
             row_str = f"{row}|"
             for col in range(self.cols):
@@ -103,5 +306,5 @@ class Grid:
                     row_str += "."
                 row_str += " "
             lines.append(row_str)
-        
+
         return "\n".join(lines)
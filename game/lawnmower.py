@@ -32,7 +32,7 @@ class LawnMowerType(IntEnum):
     SUPER_MOWER = 3  # 超级小推车
 
 
-@dataclass
+@dataclass(slots=True)
 class LawnmowerInfo:
     """
     Information about a lawnmower on the field
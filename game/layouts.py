@@ -0,0 +1,239 @@
+"""
+Entity Struct Layouts
+Precompiled decode specializations generated from data.offsets
+
+Every fixed-layout game structure (zombie, plant, projectile,
+lawnmower, seed card, place item, board scalars) gets its layout
+compiled once at import time from the Offset constants into a single
+struct.Struct, so decoding a record is one unpack_from plus tuple
+assignment instead of per-field attribute lookups and address
+arithmetic. The generated spans are validated against the entity
+stride constants (Offset.ZOMBIE_SIZE etc.) at import, turning a bad
+offset edit into an immediate startup failure rather than silently
+corrupt reads.
+"""
+
+import struct
+from typing import Dict, List, Tuple
+
+from data.offsets import Offset
+
+
+class StructLayout:
+    """
+    Precompiled decoder for a fixed-layout game structure
+
+    Compiles a list of (name, offset, fmt) fields into a single
+    struct.Struct so a whole record decodes with one unpack_from
+    instead of one ReadProcessMemory per field. Two fields may share
+    an offset (aliased memory locations like P_PUMPKIN_HP and
+    P_BLOVER_COUNTDOWN); both names receive the same value.
+    """
+
+    def __init__(self, fields: List[Tuple[str, int, str]]):
+        """
+        Initialize layout
+
+        Args:
+            fields: List of (field_name, byte_offset, struct_format) tuples.
+                    Format chars: 'i' = int32, 'f' = float32, '?' = bool byte
+        """
+        # Group aliased fields that share an offset
+        by_offset: Dict[int, Tuple[str, List[str]]] = {}
+        for name, offset, fmt in fields:
+            if offset in by_offset:
+                if by_offset[offset][0] != fmt:
+                    raise ValueError(f"Conflicting formats at offset {offset:#x}")
+                by_offset[offset][1].append(name)
+            else:
+                by_offset[offset] = (fmt, [name])
+
+        # Build one little-endian format string with padding between fields
+        parts = ['<']
+        names: List[Tuple[str, ...]] = []
+        pos = 0
+        for offset in sorted(by_offset):
+            fmt, field_names = by_offset[offset]
+            if offset < pos:
+                raise ValueError(f"Overlapping field at offset {offset:#x}")
+            if offset > pos:
+                parts.append(f'{offset - pos}x')
+            parts.append(fmt)
+            names.append(tuple(field_names))
+            pos = offset + struct.calcsize(fmt)
+
+        self.struct = struct.Struct(''.join(parts))
+        self.names = tuple(names)
+        # Number of bytes needed from record start to decode all fields
+        self.span = pos
+
+    def decode(self, buf: bytes, offset: int = 0) -> dict:
+        """Decode one record from a raw buffer into a field dict"""
+        result = {}
+        for field_names, value in zip(self.names, self.struct.unpack_from(buf, offset)):
+            for name in field_names:
+                result[name] = value
+        return result
+
+
+def np_dtype(fields: List[Tuple[str, int, str]], itemsize: int):
+    """
+    Build a numpy structured dtype mirroring a field table
+
+    Explicit offsets allow aliased fields and gaps, so a raw entity
+    array buffer can be viewed in place with np.frombuffer.
+    """
+    import numpy as np
+    formats = {'i': '<i4', 'f': '<f4', '?': '|u1'}
+    return np.dtype({
+        'names': [name for name, _, _ in fields],
+        'offsets': [offset for _, offset, _ in fields],
+        'formats': [formats[fmt] for _, _, fmt in fields],
+        'itemsize': itemsize,
+    })
+
+
+# ============================================================================
+# Generated entity layouts (field names match the Info dataclass kwargs;
+# '_dead' is the liveness flag used to skip empty slots)
+# ============================================================================
+
+ZOMBIE_FIELDS = [
+    ('row', Offset.Z_ROW, 'i'),
+    ('x', Offset.Z_X, 'f'),
+    ('y', Offset.Z_Y, 'f'),
+    ('type', Offset.Z_TYPE, 'i'),
+    ('hp', Offset.Z_HP, 'i'),
+    ('hp_max', Offset.Z_HP_MAX, 'i'),
+    ('accessory_hp', Offset.Z_ACCESSORY_HP_1, 'i'),
+    ('state', Offset.Z_STATE, 'i'),
+    ('speed', Offset.Z_SPEED, 'f'),
+    ('slow_countdown', Offset.Z_SLOW_COUNTDOWN, 'i'),
+    ('freeze_countdown', Offset.Z_FREEZE_COUNTDOWN, 'i'),
+    ('butter_countdown', Offset.Z_BUTTER_COUNTDOWN, 'i'),
+    ('at_wave', Offset.Z_AT_WAVE, 'i'),
+    ('height', Offset.Z_HEIGHT, 'f'),
+    ('exist_time', Offset.Z_EXIST_TIME, 'i'),
+    ('state_countdown', Offset.Z_STATE_COUNTDOWN, 'i'),
+    ('is_eating', Offset.Z_IS_EAT, '?'),
+    ('hurt_width', Offset.Z_HURT_WIDTH, 'i'),
+    ('hurt_height', Offset.Z_HURT_HEIGHT, 'i'),
+    ('bullet_x', Offset.Z_BULLET_X, 'i'),
+    ('bullet_y', Offset.Z_BULLET_Y, 'i'),
+    ('attack_x', Offset.Z_ATTACK_X, 'i'),
+    ('attack_y', Offset.Z_ATTACK_Y, 'i'),
+    ('_dead', Offset.Z_DEAD, '?'),
+]
+ZOMBIE_LAYOUT = StructLayout(ZOMBIE_FIELDS)
+
+PLANT_FIELDS = [
+    ('row', Offset.P_ROW, 'i'),
+    ('col', Offset.P_COL, 'i'),
+    ('type', Offset.P_TYPE, 'i'),
+    ('hp', Offset.P_HP, 'i'),
+    ('hp_max', Offset.P_HP_MAX, 'i'),
+    ('state', Offset.P_STATE, 'i'),
+    ('shoot_countdown', Offset.P_SHOOT_COUNTDOWN, 'i'),
+    ('effective', Offset.P_EFFECTIVE, 'i'),
+    ('pumpkin_hp', Offset.P_PUMPKIN_HP, 'i'),
+    ('cob_countdown', Offset.P_COB_COUNTDOWN, 'i'),
+    ('cob_ready', Offset.P_COB_READY, '?'),
+    ('visible', Offset.P_VISIBLE, '?'),
+    ('explode_countdown', Offset.P_EXPLODE_COUNTDOWN, 'i'),
+    ('blover_countdown', Offset.P_BLOVER_COUNTDOWN, 'i'),
+    ('mushroom_countdown', Offset.P_MUSHROOM_COUNTDOWN, 'i'),
+    ('bungee_state', Offset.P_BUNGEE_STATE, 'i'),
+    ('hurt_width', Offset.P_HURT_WIDTH, 'i'),
+    ('hurt_height', Offset.P_HURT_HEIGHT, 'i'),
+    ('_dead', Offset.P_DEAD, '?'),
+]
+PLANT_LAYOUT = StructLayout(PLANT_FIELDS)
+
+PROJECTILE_FIELDS = [
+    ('x', Offset.PR_X, 'f'),
+    ('y', Offset.PR_Y, 'f'),
+    ('row', Offset.PR_ROW, 'i'),
+    ('type', Offset.PR_TYPE, 'i'),
+    ('exist_time', Offset.PR_EXIST_TIME, 'i'),
+    ('is_dead', Offset.PR_DEAD, '?'),
+    ('cob_target_x', Offset.PR_COB_TARGET_X, 'f'),
+    ('cob_target_row', Offset.PR_COB_TARGET_ROW, 'i'),
+]
+PROJECTILE_LAYOUT = StructLayout(PROJECTILE_FIELDS)
+
+LAWNMOWER_FIELDS = [
+    ('row', Offset.LM_ROW, 'i'),
+    ('x', Offset.LM_X, 'f'),
+    ('state', Offset.LM_STATE, 'i'),
+    ('is_dead', Offset.LM_DEAD, '?'),
+    ('mower_type', Offset.LM_TYPE, 'i'),
+]
+LAWNMOWER_LAYOUT = StructLayout(LAWNMOWER_FIELDS)
+
+PLACE_ITEM_FIELDS = [
+    ('row', Offset.PI_ROW, 'i'),
+    ('col', Offset.PI_COL, 'i'),
+    ('type', Offset.PI_TYPE, 'i'),
+    ('value', Offset.PI_VALUE, 'i'),
+    ('is_dead', Offset.PI_DEAD, '?'),
+]
+PLACE_ITEM_LAYOUT = StructLayout(PLACE_ITEM_FIELDS)
+
+SEED_FIELDS = [
+    ('type', Offset.S_TYPE, 'i'),
+    ('recharge_countdown', Offset.S_RECHARGE_COUNTDOWN, 'i'),
+    ('recharge_time', Offset.S_RECHARGE_TIME, 'i'),
+    ('usable', Offset.S_USABLE, '?'),
+    ('imitator_type', Offset.S_IMITATOR_TYPE, 'i'),
+]
+SEED_LAYOUT = StructLayout(SEED_FIELDS)
+
+# Board scalar fields, decoded relative to the lowest offset (SCENE) so the
+# whole block reads with a single ReadProcessMemory
+BOARD_SCALAR_BASE = Offset.SCENE
+BOARD_SCALAR_LAYOUT = StructLayout([
+    ('sun', Offset.SUN - BOARD_SCALAR_BASE, 'i'),
+    ('wave', Offset.WAVE - BOARD_SCALAR_BASE, 'i'),
+    ('total_waves', Offset.TOTAL_WAVE - BOARD_SCALAR_BASE, 'i'),
+    ('refresh_countdown', Offset.REFRESH_COUNTDOWN - BOARD_SCALAR_BASE, 'i'),
+    ('huge_wave_countdown', Offset.HUGE_WAVE_COUNTDOWN - BOARD_SCALAR_BASE, 'i'),
+    ('game_clock', Offset.GAME_CLOCK - BOARD_SCALAR_BASE, 'i'),
+    ('global_clock', Offset.GLOBAL_CLOCK - BOARD_SCALAR_BASE, 'i'),
+    ('initial_countdown', Offset.INITIAL_COUNTDOWN - BOARD_SCALAR_BASE, 'i'),
+    ('click_pao_countdown', Offset.CLICK_PAO_COUNTDOWN - BOARD_SCALAR_BASE, 'i'),
+    ('zombie_refresh_hp', Offset.ZOMBIE_REFRESH_HP - BOARD_SCALAR_BASE, 'i'),
+    ('scene', Offset.SCENE - BOARD_SCALAR_BASE, 'i'),
+])
+
+
+def _validate_layouts():
+    """
+    Sanity-check generated layouts against the entity stride constants
+
+    A field offset past the record stride almost always means a typo
+    in data.offsets; failing here at import beats reading garbage from
+    a neighbouring slot at runtime. The seed layout is the documented
+    exception: its fields are absolute offsets that extend past the
+    0x50 stride into the next card's slot, so seed reads must be
+    span-sized rather than stride-sized (see GameReader).
+    """
+    checks = [
+        ('zombie', ZOMBIE_LAYOUT, Offset.ZOMBIE_SIZE),
+        ('plant', PLANT_LAYOUT, Offset.PLANT_SIZE),
+        ('projectile', PROJECTILE_LAYOUT, Offset.PROJECTILE_SIZE),
+        ('lawnmower', LAWNMOWER_LAYOUT, Offset.LAWNMOWER_SIZE),
+        ('place_item', PLACE_ITEM_LAYOUT, Offset.PLACE_ITEM_SIZE),
+    ]
+    for name, layout, stride in checks:
+        if layout.span > stride:
+            raise ValueError(
+                f"{name} layout spans {layout.span:#x} bytes but the "
+                f"record stride is only {stride:#x} - check data.offsets")
+    # Seeds: span may exceed the stride, but not by more than one record
+    if SEED_LAYOUT.span > 2 * Offset.SEED_SIZE:
+        raise ValueError(
+            f"seed layout spans {SEED_LAYOUT.span:#x} bytes, more than "
+            f"two {Offset.SEED_SIZE:#x}-byte records - check data.offsets")
+
+
+_validate_layouts()
@@ -14,7 +14,7 @@ class PlaceItemType:
     BRAIN = 3  # ZomBotany brain target
 
 
-@dataclass
+@dataclass(slots=True)
 class PlaceItemInfo:
     """
     Information about a place item on the field
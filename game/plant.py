@@ -18,7 +18,7 @@ from data.plants import (
 from data.constants import GRID_WIDTH, LAWN_LEFT_X
 
 
-@dataclass
+@dataclass(slots=True)
 class PlantInfo:
     """
     Information about a plant on the field
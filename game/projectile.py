@@ -24,7 +24,7 @@ class ProjectileType:
     KERNEL = 13
 
 
-@dataclass
+@dataclass(slots=True)
 class ProjectileInfo:
     """
     Information about a projectile on the field
@@ -3,17 +3,81 @@ Game Reader Module
 Factory class for reading game objects from memory
 """
 
-from typing import List
+import struct
+from typing import Dict, List, Optional, Tuple
 
 from data.offsets import Offset
 from memory.reader import MemoryReader
+from utils import perf
+# Entity struct layouts are generated and validated in game.layouts;
+# imported under the module-private aliases used throughout this file
+from game.layouts import (
+    StructLayout as _StructLayout,
+    np_dtype as _np_dtype,
+    ZOMBIE_FIELDS as _ZOMBIE_FIELDS,
+    ZOMBIE_LAYOUT as _ZOMBIE_LAYOUT,
+    PLANT_FIELDS as _PLANT_FIELDS,
+    PLANT_LAYOUT as _PLANT_LAYOUT,
+    PROJECTILE_LAYOUT as _PROJECTILE_LAYOUT,
+    LAWNMOWER_LAYOUT as _LAWNMOWER_LAYOUT,
+    PLACE_ITEM_LAYOUT as _PLACE_ITEM_LAYOUT,
+    SEED_FIELDS as _SEED_FIELDS,
+    SEED_LAYOUT as _SEED_LAYOUT,
+    BOARD_SCALAR_BASE as _BOARD_SCALAR_BASE,
+    BOARD_SCALAR_LAYOUT as _BOARD_SCALAR_LAYOUT,
+)
 from game.zombie import ZombieInfo
 from game.plant import PlantInfo
 from game.projectile import ProjectileInfo, ProjectileType
 from game.lawnmower import LawnmowerInfo
 from game.place_item import PlaceItemInfo
-from game.state import GameState, SeedInfo
+from game.state import (
+    GameState, SeedInfo,
+    OBS_ROWS, OBS_COLS, ZOMBIE_FEATURES, SEED_FEATURES, SCALAR_FEATURES,
+    allocate_observation,
+)
 from game.grid import Grid
+from game.wave_timeline import WaveTimeline
+
+
+# Field masks for selective state reads. Bit values match the STATE_*
+# constants in hook_client.protocol so both read paths share one
+# vocabulary (defined here as well to keep game/ importable without
+# the hook client's dependencies).
+STATE_ZOMBIES = 0x01
+STATE_PLANTS = 0x02
+STATE_SEEDS = 0x04
+STATE_PROJECTILES = 0x08
+STATE_LAWNMOWERS = 0x10
+STATE_ITEMS = 0x20
+STATE_GRID = 0x40  # grid types, ice trails and the derived plant grid
+STATE_ALL = 0x7F
+
+
+class StateDelta:
+    """
+    Incremental state read result
+
+    Holds only the entity slots whose raw bytes changed since the
+    previous read_state_delta() call, plus the always-volatile board
+    scalars. Slots that flipped to dead are reported by index in the
+    removed_* lists.
+    """
+
+    def __init__(self, game_clock: int = 0, changed: bool = False):
+        self.game_clock = game_clock
+        self.changed = changed
+        self.scalars: dict = {}
+        self.changed_zombies: List[ZombieInfo] = []
+        self.changed_plants: List[PlantInfo] = []
+        self.changed_seeds: List[SeedInfo] = []
+        self.removed_zombies: List[int] = []
+        self.removed_plants: List[int] = []
+
+    def __repr__(self) -> str:
+        return (f"StateDelta(clock={self.game_clock}, changed={self.changed}, "
+                f"zombies={len(self.changed_zombies)}+{len(self.removed_zombies)}-, "
+                f"plants={len(self.changed_plants)}+{len(self.removed_plants)}-)")
 
 
 class GameReader:
@@ -23,15 +87,113 @@ class GameReader:
     Converts raw memory addresses into structured Python objects.
     """
     
-    def __init__(self, reader: MemoryReader):
+    def __init__(self, reader: MemoryReader, bulk: bool = True,
+                 recycle: bool = False):
         """
         Initialize GameReader
-        
+
         Args:
             reader: MemoryReader instance for reading memory
+            bulk: Read each entity array with one ReadProcessMemory and
+                  decode fields locally (default). Set False to fall back
+                  to per-field reads for debugging.
+            recycle: Reuse the previous snapshot's Info objects instead of
+                     allocating new ones each read. Cuts GC pressure when
+                     polling at high rates, but a snapshot then stays valid
+                     only until the next read — don't hold references.
         """
         self.reader = reader
-    
+        self.bulk = bulk
+        self.recycle = recycle
+        # Per-entity-type freelists for recycle mode (last hand-out list)
+        self._pools: Dict[str, list] = {}
+        # Level-static cache, keyed by board pointer (MakeNewBoard allocates
+        # a fresh Board per level, so the pointer doubles as a generation id)
+        self._static_cache: Dict[tuple, object] = {}
+        # Previous raw entity buffers for read_state_delta()
+        self._delta_board = 0
+        self._delta_bufs: Dict[str, bytes] = {}
+        self._delta_clock = -1
+
+    def invalidate_cache(self):
+        """Drop cached level-static data and delta baselines"""
+        self._static_cache.clear()
+        self._delta_bufs.clear()
+        self._delta_board = 0
+        self._delta_clock = -1
+
+    def get_perf_stats(self) -> dict:
+        """Recorded read-phase latency summaries (utils.perf must be enabled)"""
+        return perf.get_perf_stats('reader.')
+
+    def _cached_static(self, key: tuple, loader):
+        """Return cached level-static data, loading it once per board"""
+        if key in self._static_cache:
+            return self._static_cache[key]
+        # Evict entries from previous boards
+        board = key[1]
+        stale = [k for k in self._static_cache if k[1] != board]
+        for k in stale:
+            del self._static_cache[k]
+        value = loader()
+        self._static_cache[key] = value
+        return value
+
+    # ========================================================================
+    # Bulk Array Reader
+    # ========================================================================
+
+    def _read_record_array(self, array_addr: int, count: int, stride: int,
+                           layout: _StructLayout) -> List[dict]:
+        """
+        Read an entire entity array with one syscall and decode every record
+
+        Args:
+            array_addr: Base address of the entity array
+            count: Number of records to decode
+            stride: Size of each record in bytes
+            layout: Precompiled layout for the record type
+
+        Returns:
+            List of decoded field dicts (all slots, dead and alive)
+        """
+        if array_addr == 0 or count <= 0:
+            return []
+        # Some layouts (seeds) reference fields past the record stride, so
+        # size the read from the last record's span rather than count*stride
+        size = (count - 1) * stride + layout.span
+        buf = self.reader.read_bytes(array_addr, size)
+        return [layout.decode(buf, i * stride) for i in range(count)]
+
+    def _build_record(self, key: str, cls, pos: int, index: int, fields: dict):
+        """
+        Construct (or recycle) one entity Info object
+
+        In recycle mode the object at position `pos` of the previous
+        hand-out list is overwritten in place instead of allocating a
+        new instance; the entity dataclasses use __slots__, so setattr
+        hits fixed slots with no per-instance dict.
+
+        Args:
+            key: Pool name (one per entity type)
+            cls: Info dataclass to build
+            pos: Position in the result list being built
+            index: Entity array slot index
+            fields: Decoded field dict (layout field names)
+
+        Returns:
+            Filled Info instance
+        """
+        if self.recycle:
+            pool = self._pools.get(key)
+            if pool is not None and pos < len(pool):
+                obj = pool[pos]
+                obj.index = index
+                for name, value in fields.items():
+                    setattr(obj, name, value)
+                return obj
+        return cls(index=index, **fields)
+
     # ========================================================================
     # Single Entity Readers
     # ========================================================================
@@ -205,15 +367,27 @@ class GameReader:
         zombie_array = self.reader.get_zombie_array()
         if zombie_array == 0:
             return zombies
-        
+
         zombie_count_max = self.reader.get_zombie_count_max()
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                zombie_array, zombie_count_max, Offset.ZOMBIE_SIZE, _ZOMBIE_LAYOUT)
+            for i, fields in enumerate(records):
+                if fields.pop('_dead'):
+                    continue
+                zombies.append(self._build_record(
+                    'zombies', ZombieInfo, len(zombies), i, fields))
+            if self.recycle:
+                self._pools['zombies'] = zombies
+            return zombies
+
         for i in range(zombie_count_max):
             addr = zombie_array + i * Offset.ZOMBIE_SIZE
             is_dead = self.reader.read_bool(addr + Offset.Z_DEAD)
             if not is_dead:
                 zombies.append(self.read_zombie(addr, i))
-        
+
         return zombies
     
     def read_all_plants(self) -> List[PlantInfo]:
@@ -229,7 +403,20 @@ class GameReader:
             return plants
         
         plant_count_max = self.reader.get_plant_count_max()
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                plant_array, plant_count_max, Offset.PLANT_SIZE, _PLANT_LAYOUT)
+            for i, fields in enumerate(records):
+                if fields.pop('_dead'):
+                    continue
+                fields['effective'] = fields['effective'] != 0
+                plants.append(self._build_record(
+                    'plants', PlantInfo, len(plants), i, fields))
+            if self.recycle:
+                self._pools['plants'] = plants
+            return plants
+
         for i in range(plant_count_max):
             addr = plant_array + i * Offset.PLANT_SIZE
             is_dead = self.reader.read_bool(addr + Offset.P_DEAD)
@@ -255,7 +442,20 @@ class GameReader:
             return projectiles
         
         projectile_count_max = self.reader.read_int(board + Offset.PROJECTILE_COUNT_MAX)
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                projectile_array, projectile_count_max,
+                Offset.PROJECTILE_SIZE, _PROJECTILE_LAYOUT)
+            for i, fields in enumerate(records):
+                if fields['is_dead']:
+                    continue
+                projectiles.append(self._build_record(
+                    'projectiles', ProjectileInfo, len(projectiles), i, fields))
+            if self.recycle:
+                self._pools['projectiles'] = projectiles
+            return projectiles
+
         for i in range(projectile_count_max):
             addr = projectile_array + i * Offset.PROJECTILE_SIZE
             is_dead = self.reader.read_bool(addr + Offset.PR_DEAD)
@@ -281,7 +481,20 @@ class GameReader:
             return lawnmowers
         
         lawnmower_count_max = self.reader.read_int(board + Offset.LAWNMOWER_COUNT_MAX)
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                lawnmower_array, lawnmower_count_max,
+                Offset.LAWNMOWER_SIZE, _LAWNMOWER_LAYOUT)
+            for i, fields in enumerate(records):
+                if fields['is_dead']:
+                    continue
+                lawnmowers.append(self._build_record(
+                    'lawnmowers', LawnmowerInfo, len(lawnmowers), i, fields))
+            if self.recycle:
+                self._pools['lawnmowers'] = lawnmowers
+            return lawnmowers
+
         for i in range(lawnmower_count_max):
             addr = lawnmower_array + i * Offset.LAWNMOWER_SIZE
             is_dead = self.reader.read_bool(addr + Offset.LM_DEAD)
@@ -307,7 +520,20 @@ class GameReader:
             return items
         
         place_item_count_max = self.reader.read_int(board + Offset.PLACE_ITEM_COUNT_MAX)
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                place_item_array, place_item_count_max,
+                Offset.PLACE_ITEM_SIZE, _PLACE_ITEM_LAYOUT)
+            for i, fields in enumerate(records):
+                if fields['is_dead']:
+                    continue
+                items.append(self._build_record(
+                    'place_items', PlaceItemInfo, len(items), i, fields))
+            if self.recycle:
+                self._pools['place_items'] = items
+            return items
+
         for i in range(place_item_count_max):
             addr = place_item_array + i * Offset.PLACE_ITEM_SIZE
             is_dead = self.reader.read_bool(addr + Offset.PI_DEAD)
@@ -327,11 +553,25 @@ class GameReader:
         board = self.reader.get_board()
         if board == 0:
             return ice_trails
-        
+
+        if self.bulk:
+            # mIceMinX[6] and mIceTimer[6] are adjacent: one read covers both
+            buf = self.reader.read_bytes(board + Offset.ICE_MIN_X, 12 * 4)
+            values = struct.unpack('<12i', buf)
+            for row in range(6):
+                timer = values[6 + row]
+                if timer > 0:
+                    ice_trails.append({
+                        'row': row,
+                        'min_x': values[row],
+                        'timer': timer,
+                    })
+            return ice_trails
+
         for row in range(6):
             min_x = self.reader.read_int(board + Offset.ICE_MIN_X + row * 4)
             timer = self.reader.read_int(board + Offset.ICE_TIMER + row * 4)
-            
+
             # 如果 timer > 0，说明这行有冰道
             if timer > 0:
                 ice_trails.append({
@@ -361,12 +601,17 @@ class GameReader:
             return zombies
         
         base = board + Offset.ZOMBIE_LIST + wave * Offset.ZOMBIE_LIST_WAVE_SIZE
-        
+
+        if self.bulk:
+            buf = self.reader.read_bytes(base, Offset.ZOMBIE_LIST_WAVE_SIZE)
+            types = struct.unpack(f'<{Offset.ZOMBIE_LIST_MAX_PER_WAVE}i', buf)
+            return [t for t in types if t != -1]  # -1 表示空槽位
+
         for i in range(Offset.ZOMBIE_LIST_MAX_PER_WAVE):
             zombie_type = self.reader.read_int(base + i * 4)
             if zombie_type != -1:  # -1 表示空槽位
                 zombies.append(zombie_type)
-        
+
         return zombies
     
     def read_all_spawn_lists(self, total_waves: int) -> List[List[int]]:
@@ -379,11 +624,53 @@ class GameReader:
         Returns:
             List of lists, each containing ZombieType values for that wave
         """
+        waves = min(total_waves, Offset.ZOMBIE_LIST_MAX_WAVES)
+
+        if self.bulk and waves > 0:
+            board = self.reader.get_board()
+            if board == 0:
+                return []
+            # Spawn lists are rolled once at board creation; cache per board
+            return self._cached_static(
+                ('spawn_lists', board, waves),
+                lambda: self._read_all_spawn_lists_bulk(board, waves))
+
         all_waves = []
-        for wave in range(min(total_waves, Offset.ZOMBIE_LIST_MAX_WAVES)):
+        for wave in range(waves):
             all_waves.append(self.read_zombie_spawn_list(wave))
         return all_waves
+
+    def _read_all_spawn_lists_bulk(self, board: int, waves: int) -> List[List[int]]:
+        """Bulk-read spawn lists for all waves (uncached)"""
+        per_wave = Offset.ZOMBIE_LIST_MAX_PER_WAVE
+        buf = self.reader.read_bytes(
+            board + Offset.ZOMBIE_LIST, waves * Offset.ZOMBIE_LIST_WAVE_SIZE)
+        types = struct.unpack(f'<{waves * per_wave}i', buf)
+        return [[t for t in types[w * per_wave:(w + 1) * per_wave] if t != -1]
+                for w in range(waves)]
     
+    def get_wave_timeline(self, total_waves: int) -> Optional['WaveTimeline']:
+        """
+        Get the precomputed wave timeline for the current level
+
+        Built from the spawn lists on first call and cached per board;
+        later calls (and every snapshot the timeline is attached to)
+        share the same object.
+
+        Args:
+            total_waves: Total number of waves in this level
+
+        Returns:
+            WaveTimeline, or None when no board exists
+        """
+        board = self.reader.get_board()
+        if board == 0 or total_waves <= 0:
+            return None
+        waves = min(total_waves, Offset.ZOMBIE_LIST_MAX_WAVES)
+        return self._cached_static(
+            ('wave_timeline', board, waves),
+            lambda: WaveTimeline(self.read_all_spawn_lists(total_waves)))
+
     def read_grid_types(self) -> List[List[int]]:
         """
         Read grid square types for the entire field
@@ -396,7 +683,13 @@ class GameReader:
         board = self.reader.get_board()
         if board == 0:
             return [[0] * 9 for _ in range(6)]
-        
+
+        if self.bulk:
+            # Grid square types are fixed once the board is built; cache per board
+            cached = self._cached_static(
+                ('grid_types', board), lambda: self._read_grid_types_bulk(board))
+            return [list(row) for row in cached]
+
         for row in range(6):
             row_data = []
             for col in range(9):
@@ -405,9 +698,15 @@ class GameReader:
                 grid_type = self.reader.read_int(board + Offset.GRID_TYPE_LIST + offset)
                 row_data.append(grid_type)
             grid.append(row_data)
-        
+
         return grid
 
+    def _read_grid_types_bulk(self, board: int) -> List[tuple]:
+        """Bulk-read the 6x9 grid type array (uncached)"""
+        buf = self.reader.read_bytes(board + Offset.GRID_TYPE_LIST, 6 * 9 * 4)
+        values = struct.unpack('<54i', buf)
+        return [values[row * 9:(row + 1) * 9] for row in range(6)]
+
     def read_all_seeds(self, seed_count: int = 10) -> List[SeedInfo]:
         """
         Read all seed cards from memory
@@ -422,7 +721,16 @@ class GameReader:
         seed_array = self.reader.get_seed_array()
         if seed_array == 0:
             return seeds
-        
+
+        if self.bulk:
+            records = self._read_record_array(
+                seed_array, seed_count, Offset.SEED_SIZE, _SEED_LAYOUT)
+            seeds = [self._build_record('seeds', SeedInfo, i, i, fields)
+                     for i, fields in enumerate(records)]
+            if self.recycle:
+                self._pools['seeds'] = seeds
+            return seeds
+
         for i in range(seed_count):
             addr = seed_array + i * Offset.SEED_SIZE
             seeds.append(self.read_seed(addr, i))
@@ -433,44 +741,89 @@ class GameReader:
     # Full State Reader
     # ========================================================================
     
-    def read_game_state(self) -> GameState:
+    def read_game_state(self, fields: int = STATE_ALL) -> GameState:
         """
         Read complete game state from memory
-        
+
+        Args:
+            fields: STATE_* mask selecting which entity groups to read.
+                    Unselected groups come back as empty lists, so a
+                    sun-management loop polling with STATE_SEEDS pays
+                    for one array read instead of eight. Scalars are
+                    always included.
+
         Returns:
-            GameState instance with all game data
+            GameState instance with the selected game data
         """
         board = self.reader.get_board()
         if board == 0:
             return GameState()
-        
-        # Read all entities
-        zombies = self.read_all_zombies()
-        plants = self.read_all_plants()
-        projectiles = self.read_all_projectiles()
-        lawnmowers = self.read_all_lawnmowers()
-        place_items = self.read_all_place_items()
-        seeds = self.read_all_seeds()
-        ice_trails = self.read_ice_trails()
-        grid_types = self.read_grid_types()
-        
-        # Build plant grid
-        plant_grid = Grid()
-        for plant in plants:
-            plant_grid.set(plant.row, plant.col, plant)
-        
+
+        # A grid built without plant occupancy would report every cell
+        # empty, so a grid read always implies a plant read
+        if fields & STATE_GRID:
+            fields |= STATE_PLANTS
+
+        # Read selected entities (phase timings recorded when utils.perf
+        # is enabled)
+        zombies = perf.timed_call(
+            'reader.zombies', self.read_all_zombies) \
+            if fields & STATE_ZOMBIES else []
+        plants = perf.timed_call(
+            'reader.plants', self.read_all_plants) \
+            if fields & STATE_PLANTS else []
+        projectiles = perf.timed_call(
+            'reader.projectiles', self.read_all_projectiles) \
+            if fields & STATE_PROJECTILES else []
+        lawnmowers = perf.timed_call(
+            'reader.lawnmowers', self.read_all_lawnmowers) \
+            if fields & STATE_LAWNMOWERS else []
+        place_items = perf.timed_call(
+            'reader.place_items', self.read_all_place_items) \
+            if fields & STATE_ITEMS else []
+        seeds = perf.timed_call(
+            'reader.seeds', self.read_all_seeds) \
+            if fields & STATE_SEEDS else []
+        if fields & STATE_GRID:
+            ice_trails = perf.timed_call('reader.ice_trails', self.read_ice_trails)
+            grid_types = perf.timed_call('reader.grid_types', self.read_grid_types)
+        else:
+            ice_trails = []
+            grid_types = []
+
+        # Build plant grid (spatial index: occupancy + terrain masks).
+        # Left as None when grid data wasn't read so GameState's lazy
+        # _ensure_plant_grid rebuild still sees plant occupancy — an
+        # empty Grid here would make every cell report as empty
+        plant_grid = None
+        if fields & STATE_GRID:
+            plant_grid = Grid()
+            for plant in plants:
+                plant_grid.set(plant.row, plant.col, plant)
+            plant_grid.set_grid_types(grid_types)
+
+        if self.bulk:
+            # All board scalars live in one block; fetch it with a single read
+            buf = self.reader.read_bytes(
+                board + _BOARD_SCALAR_BASE, _BOARD_SCALAR_LAYOUT.span)
+            scalars = _BOARD_SCALAR_LAYOUT.decode(buf)
+        else:
+            scalars = {
+                'sun': self.reader.read_int(board + Offset.SUN),
+                'wave': self.reader.read_int(board + Offset.WAVE),
+                'total_waves': self.reader.read_int(board + Offset.TOTAL_WAVE),
+                'refresh_countdown': self.reader.read_int(board + Offset.REFRESH_COUNTDOWN),
+                'huge_wave_countdown': self.reader.read_int(board + Offset.HUGE_WAVE_COUNTDOWN),
+                'game_clock': self.reader.read_int(board + Offset.GAME_CLOCK),
+                'global_clock': self.reader.read_int(board + Offset.GLOBAL_CLOCK),
+                'initial_countdown': self.reader.read_int(board + Offset.INITIAL_COUNTDOWN),
+                'click_pao_countdown': self.reader.read_int(board + Offset.CLICK_PAO_COUNTDOWN),
+                'zombie_refresh_hp': self.reader.read_int(board + Offset.ZOMBIE_REFRESH_HP),
+                'scene': self.reader.read_int(board + Offset.SCENE),
+            }
+
         return GameState(
-            sun=self.reader.read_int(board + Offset.SUN),
-            wave=self.reader.read_int(board + Offset.WAVE),
-            total_waves=self.reader.read_int(board + Offset.TOTAL_WAVE),
-            refresh_countdown=self.reader.read_int(board + Offset.REFRESH_COUNTDOWN),
-            huge_wave_countdown=self.reader.read_int(board + Offset.HUGE_WAVE_COUNTDOWN),
-            game_clock=self.reader.read_int(board + Offset.GAME_CLOCK),
-            global_clock=self.reader.read_int(board + Offset.GLOBAL_CLOCK),
-            initial_countdown=self.reader.read_int(board + Offset.INITIAL_COUNTDOWN),
-            click_pao_countdown=self.reader.read_int(board + Offset.CLICK_PAO_COUNTDOWN),
-            zombie_refresh_hp=self.reader.read_int(board + Offset.ZOMBIE_REFRESH_HP),
-            scene=self.reader.read_int(board + Offset.SCENE),
+            **scalars,
             zombies=zombies,
             plants=plants,
             seeds=seeds,
@@ -480,4 +833,195 @@ class GameReader:
             ice_trails=ice_trails,
             grid_types=grid_types,
             plant_grid=plant_grid,
+            # Level-static wave data, shared by reference across snapshots
+            wave_timeline=self.get_wave_timeline(scalars['total_waves']),
         )
+
+    def read_state_arrays(self, out: dict = None) -> dict:
+        """
+        Read game state directly into fixed-shape numpy observation arrays
+
+        Skips Info-object construction entirely: each entity array is
+        fetched with one bulk read and viewed in place through a numpy
+        structured dtype, then the alive slots are scattered into the
+        observation buffers with vectorized operations. Output layout
+        matches GameState.to_arrays().
+
+        Args:
+            out: Reusable buffer dict from allocate_observation();
+                 allocated fresh when omitted
+
+        Returns:
+            The filled buffer dict (same object as `out` when given)
+        """
+        import numpy as np
+
+        if out is None:
+            out = allocate_observation()
+
+        plant_type_grid = out['plant_type_grid']
+        plant_hp_grid = out['plant_hp_grid']
+        zombies_out = out['zombies']
+        seeds_out = out['seeds']
+        scalars_out = out['scalars']
+        plant_type_grid.fill(-1)
+        plant_hp_grid.fill(0.0)
+        zombies_out.fill(0.0)
+        seeds_out.fill(0.0)
+        scalars_out.fill(0.0)
+        out['zombie_count'] = 0
+
+        board = self.reader.get_board()
+        if board == 0:
+            return out
+
+        # Scalars
+        buf = self.reader.read_bytes(
+            board + _BOARD_SCALAR_BASE, _BOARD_SCALAR_LAYOUT.span)
+        scalar_fields = _BOARD_SCALAR_LAYOUT.decode(buf)
+        for k, feature in enumerate(SCALAR_FEATURES):
+            scalars_out[k] = float(scalar_fields[feature])
+
+        # Zombies
+        zombie_array = self.reader.get_zombie_array()
+        zombie_count_max = self.reader.get_zombie_count_max()
+        if zombie_array and zombie_count_max > 0:
+            dtype = _np_dtype(_ZOMBIE_FIELDS, Offset.ZOMBIE_SIZE)
+            buf = self.reader.read_bytes(
+                zombie_array, zombie_count_max * Offset.ZOMBIE_SIZE)
+            records = np.frombuffer(buf, dtype=dtype, count=zombie_count_max)
+            alive = records[(records['_dead'] == 0) & (records['hp'] > 0)]
+            count = min(len(alive), zombies_out.shape[0])
+            alive = alive[:count]
+            for k, feature in enumerate(ZOMBIE_FEATURES):
+                zombies_out[:count, k] = alive[feature]
+            out['zombie_count'] = count
+
+        # Plants
+        plant_array = self.reader.get_plant_array()
+        plant_count_max = self.reader.get_plant_count_max()
+        if plant_array and plant_count_max > 0:
+            dtype = _np_dtype(_PLANT_FIELDS, Offset.PLANT_SIZE)
+            buf = self.reader.read_bytes(
+                plant_array, plant_count_max * Offset.PLANT_SIZE)
+            records = np.frombuffer(buf, dtype=dtype, count=plant_count_max)
+            alive = records[(records['_dead'] == 0) & (records['hp'] > 0)]
+            rows = alive['row']
+            cols = alive['col']
+            valid = (rows >= 0) & (rows < OBS_ROWS) & (cols >= 0) & (cols < OBS_COLS)
+            alive = alive[valid]
+            plant_type_grid[alive['row'], alive['col']] = alive['type']
+            plant_hp_grid[alive['row'], alive['col']] = alive['hp']
+
+        # Seeds
+        seed_array = self.reader.get_seed_array()
+        if seed_array:
+            seed_count = seeds_out.shape[0]
+            dtype = _np_dtype(_SEED_FIELDS, Offset.SEED_SIZE)
+            size = (seed_count - 1) * Offset.SEED_SIZE + _SEED_LAYOUT.span
+            buf = self.reader.read_bytes(seed_array, size)
+            records = np.frombuffer(buf, dtype=dtype, count=seed_count)
+            for k, feature in enumerate(SEED_FEATURES):
+                seeds_out[:, k] = records[feature]
+
+        return out
+
+    def read_state_delta(self, since_clock: int = -1) -> StateDelta:
+        """
+        Read an incremental state snapshot
+
+        Compares each entity slot's raw bytes against the previous call
+        and decodes only the slots that changed. Between game ticks (the
+        game clock has not advanced) nothing is read beyond the board
+        scalar block, so polling faster than the tick rate is nearly free.
+
+        Args:
+            since_clock: Skip the entity scan if game_clock is still at
+                         this value (pass the clock from the last delta)
+
+        Returns:
+            StateDelta; changed is False when the clock has not advanced
+        """
+        board = self.reader.get_board()
+        if board == 0:
+            return StateDelta()
+
+        buf = self.reader.read_bytes(
+            board + _BOARD_SCALAR_BASE, _BOARD_SCALAR_LAYOUT.span)
+        scalars = _BOARD_SCALAR_LAYOUT.decode(buf)
+        clock = scalars['game_clock']
+
+        if board != self._delta_board:
+            # New level: drop baselines so every live slot reports as changed
+            self._delta_bufs.clear()
+            self._delta_board = board
+            self._delta_clock = -1
+
+        if clock == self._delta_clock or clock == since_clock:
+            delta = StateDelta(clock, changed=False)
+            delta.scalars = scalars
+            return delta
+
+        delta = StateDelta(clock, changed=True)
+        delta.scalars = scalars
+
+        zombie_array = self.reader.get_zombie_array()
+        if zombie_array:
+            self._scan_changed_slots(
+                'zombies', zombie_array, self.reader.get_zombie_count_max(),
+                Offset.ZOMBIE_SIZE, _ZOMBIE_LAYOUT,
+                lambda i, fields: delta.changed_zombies.append(
+                    ZombieInfo(index=i, **fields)),
+                delta.removed_zombies)
+
+        plant_array = self.reader.get_plant_array()
+        if plant_array:
+            self._scan_changed_slots(
+                'plants', plant_array, self.reader.get_plant_count_max(),
+                Offset.PLANT_SIZE, _PLANT_LAYOUT,
+                lambda i, fields: delta.changed_plants.append(
+                    PlantInfo(index=i, **fields)),
+                delta.removed_plants)
+
+        seed_array = self.reader.get_seed_array()
+        if seed_array:
+            self._scan_changed_slots(
+                'seeds', seed_array, 10, Offset.SEED_SIZE, _SEED_LAYOUT,
+                lambda i, fields: delta.changed_seeds.append(
+                    SeedInfo(index=i, **fields)),
+                None)
+
+        self._delta_clock = clock
+        return delta
+
+    def _scan_changed_slots(self, key: str, array_addr: int, count: int,
+                            stride: int, layout: _StructLayout,
+                            emit, removed: Optional[List[int]]):
+        """
+        Diff one entity array against its previous raw buffer
+
+        Decodes a slot only when its bytes differ from the last scan.
+        Slots that changed into the dead state go to the removed list
+        (when one is given) instead of being decoded.
+        """
+        if count <= 0:
+            return
+        size = (count - 1) * stride + layout.span
+        buf = self.reader.read_bytes(array_addr, size)
+        prev = self._delta_bufs.get(key)
+        span = layout.span
+
+        for i in range(count):
+            start = i * stride
+            chunk = buf[start:start + span]
+            if prev is not None and chunk == prev[start:start + span]:
+                continue
+            fields = layout.decode(buf, start)
+            dead = fields.pop('_dead', False)
+            if dead:
+                if removed is not None and prev is not None:
+                    removed.append(i)
+                continue
+            emit(i, fields)
+
+        self._delta_bufs[key] = buf
@@ -4,7 +4,7 @@ Represents the complete state of a PVZ game at a point in time
 """
 
 from dataclasses import dataclass, field
-from typing import List, Optional
+from typing import Dict, List, Optional
 
 from game.zombie import ZombieInfo
 from game.plant import PlantInfo
@@ -14,7 +14,55 @@ from game.lawnmower import LawnmowerInfo
 from game.place_item import PlaceItemInfo
 
 
-@dataclass
+# ============================================================================
+# Observation Spec (for to_arrays / read_state_arrays)
+# ============================================================================
+
+# Fixed observation shapes so policy networks get constant-size inputs
+OBS_ROWS = 6
+OBS_COLS = 9
+OBS_MAX_ZOMBIES = 64
+OBS_SEED_SLOTS = 10
+
+# Per-zombie feature columns of the Nx16 zombie matrix
+ZOMBIE_FEATURES = (
+    'row', 'x', 'y', 'type', 'hp', 'hp_max', 'accessory_hp', 'state',
+    'speed', 'slow_countdown', 'freeze_countdown', 'butter_countdown',
+    'at_wave', 'height', 'exist_time', 'is_eating',
+)
+
+# Per-seed feature columns
+SEED_FEATURES = ('type', 'recharge_countdown', 'recharge_time', 'usable')
+
+# Scalar feature vector layout
+SCALAR_FEATURES = (
+    'sun', 'wave', 'total_waves', 'refresh_countdown',
+    'huge_wave_countdown', 'game_clock', 'scene', 'click_pao_countdown',
+)
+
+
+def allocate_observation(max_zombies: int = OBS_MAX_ZOMBIES) -> dict:
+    """
+    Allocate a reusable observation buffer set
+
+    Pass the returned dict as `out` to GameState.to_arrays() or
+    GameReader.read_state_arrays() to avoid per-step allocations.
+
+    Returns:
+        Dict of preallocated numpy arrays
+    """
+    import numpy as np
+    return {
+        'plant_type_grid': np.full((OBS_ROWS, OBS_COLS), -1, dtype=np.int32),
+        'plant_hp_grid': np.zeros((OBS_ROWS, OBS_COLS), dtype=np.float32),
+        'zombies': np.zeros((max_zombies, len(ZOMBIE_FEATURES)), dtype=np.float32),
+        'zombie_count': 0,
+        'seeds': np.zeros((OBS_SEED_SLOTS, len(SEED_FEATURES)), dtype=np.float32),
+        'scalars': np.zeros(len(SCALAR_FEATURES), dtype=np.float32),
+    }
+
+
+@dataclass(slots=True)
 class SeedInfo:
     """Information about a seed card in the player's hand"""
     index: int
@@ -94,20 +142,127 @@ class GameState:
     
     # Grid representation (quick plant lookup)
     plant_grid: Optional[Grid] = None
+
+    # Precomputed per-level wave data (shared by reference across
+    # snapshots; see game.wave_timeline.WaveTimeline)
+    wave_timeline: Optional['WaveTimeline'] = None
+
+    # Lazily built per-snapshot indexes (analogous to plant_grid for
+    # positional lookup). A snapshot is immutable once read, so these
+    # are computed on first access and reused by every later query
+    _alive_zombies: Optional[List[ZombieInfo]] = field(
+        init=False, default=None, repr=False, compare=False)
+    _alive_plants: Optional[List[PlantInfo]] = field(
+        init=False, default=None, repr=False, compare=False)
+    _zombies_by_row: Optional[Dict[int, List[ZombieInfo]]] = field(
+        init=False, default=None, repr=False, compare=False)
+    _zombies_by_type: Optional[Dict[int, List[ZombieInfo]]] = field(
+        init=False, default=None, repr=False, compare=False)
+    _plants_by_row: Optional[Dict[int, List[PlantInfo]]] = field(
+        init=False, default=None, repr=False, compare=False)
     
+    # ========================================================================
+    # Tensor Observation
+    # ========================================================================
+
+    def to_arrays(self, out: Optional[dict] = None) -> dict:
+        """
+        Convert snapshot to fixed-shape numpy observation arrays
+
+        Produces constant-size buffers suitable for feeding a policy
+        network directly: a 6x9 plant type/hp grid, an Nx16 zombie
+        feature matrix (padded with zeros), a seed cooldown matrix and
+        a scalar feature vector.
+
+        Args:
+            out: Reusable buffer dict from allocate_observation();
+                 allocated fresh when omitted
+
+        Returns:
+            The filled buffer dict (same object as `out` when given)
+        """
+        if out is None:
+            out = allocate_observation()
+
+        plant_type_grid = out['plant_type_grid']
+        plant_hp_grid = out['plant_hp_grid']
+        plant_type_grid.fill(-1)
+        plant_hp_grid.fill(0.0)
+        for p in self.plants:
+            if p.hp > 0 and 0 <= p.row < OBS_ROWS and 0 <= p.col < OBS_COLS:
+                plant_type_grid[p.row, p.col] = p.type
+                plant_hp_grid[p.row, p.col] = p.hp
+
+        zombies = out['zombies']
+        zombies.fill(0.0)
+        max_zombies = zombies.shape[0]
+        count = 0
+        for z in self.zombies:
+            if z.hp <= 0:
+                continue
+            if count >= max_zombies:
+                break
+            for k, feature in enumerate(ZOMBIE_FEATURES):
+                zombies[count, k] = float(getattr(z, feature))
+            count += 1
+        out['zombie_count'] = count
+
+        seeds = out['seeds']
+        seeds.fill(0.0)
+        for s in self.seeds[:seeds.shape[0]]:
+            for k, feature in enumerate(SEED_FEATURES):
+                seeds[s.index, k] = float(getattr(s, feature))
+
+        scalars = out['scalars']
+        for k, feature in enumerate(SCALAR_FEATURES):
+            scalars[k] = float(getattr(self, feature))
+
+        return out
+
     # ========================================================================
     # Utility Properties
     # ========================================================================
     
     @property
     def alive_zombies(self) -> List[ZombieInfo]:
-        """Get all alive zombies"""
-        return [z for z in self.zombies if z.hp > 0]
-    
+        """Get all alive zombies (cached on first access)"""
+        if self._alive_zombies is None:
+            self._alive_zombies = [z for z in self.zombies if z.hp > 0]
+        return self._alive_zombies
+
     @property
     def alive_plants(self) -> List[PlantInfo]:
-        """Get all alive plants"""
-        return [p for p in self.plants if p.hp > 0]
+        """Get all alive plants (cached on first access)"""
+        if self._alive_plants is None:
+            self._alive_plants = [p for p in self.plants if p.hp > 0]
+        return self._alive_plants
+
+    def _zombie_row_index(self) -> Dict[int, List[ZombieInfo]]:
+        """Alive zombies bucketed by row, built once per snapshot"""
+        if self._zombies_by_row is None:
+            index: Dict[int, List[ZombieInfo]] = {}
+            for z in self.alive_zombies:
+                index.setdefault(z.row, []).append(z)
+            self._zombies_by_row = index
+        return self._zombies_by_row
+
+    def _zombie_type_index(self) -> Dict[int, List[ZombieInfo]]:
+        """Alive zombies bucketed by type, built once per snapshot"""
+        if self._zombies_by_type is None:
+            index: Dict[int, List[ZombieInfo]] = {}
+            for z in self.alive_zombies:
+                index.setdefault(z.type, []).append(z)
+            self._zombies_by_type = index
+        return self._zombies_by_type
+
+    def _plant_row_index(self) -> Dict[int, List[PlantInfo]]:
+        """Alive plants bucketed by row, built once per snapshot"""
+        if self._plants_by_row is None:
+            index: Dict[int, List[PlantInfo]] = {}
+            for p in self.alive_plants:
+                index.setdefault(p.row, []).append(p)
+            self._plants_by_row = index
+        return self._plants_by_row
     
     @property
     def zombie_count(self) -> int:
@@ -135,7 +290,7 @@ class GameState:
     
     def get_zombies_in_row(self, row: int) -> List[ZombieInfo]:
         """Get all zombies in a specific row"""
-        return [z for z in self.alive_zombies if z.row == row]
+        return self._zombie_row_index().get(row, [])
     
     def get_closest_zombie_in_row(self, row: int) -> Optional[ZombieInfo]:
         """Get the closest zombie to the left in a row"""
@@ -146,7 +301,7 @@ class GameState:
     
     def get_zombies_by_type(self, zombie_type: int) -> List[ZombieInfo]:
         """Get all zombies of a specific type"""
-        return [z for z in self.alive_zombies if z.type == zombie_type]
+        return self._zombie_type_index().get(zombie_type, [])
     
     def get_dangerous_zombies(self) -> List[ZombieInfo]:
         """Get all zombies with high threat level"""
@@ -157,27 +312,47 @@ class GameState:
     # Plant Queries
     # ========================================================================
     
+    def _ensure_plant_grid(self) -> Grid:
+        """
+        Get the spatial plant index, building it lazily when the
+        snapshot came without one (e.g. a masked read)
+        """
+        if self.plant_grid is None:
+            grid = Grid()
+            for plant in self.alive_plants:
+                grid.set(plant.row, plant.col, plant)
+            grid.set_grid_types(self.grid_types)
+            self.plant_grid = grid
+        return self.plant_grid
+
     def get_plant_at(self, row: int, col: int) -> Optional[PlantInfo]:
         """Get plant at a specific grid position"""
-        if self.plant_grid:
-            return self.plant_grid.get(row, col)
-        # Fallback to linear search
-        for plant in self.alive_plants:
-            if plant.row == row and plant.col == col:
-                return plant
-        return None
+        return self._ensure_plant_grid().get(row, col)
     
     def get_plants_in_row(self, row: int) -> List[PlantInfo]:
         """Get all plants in a specific row"""
-        return [p for p in self.alive_plants if p.row == row]
+        return self._plant_row_index().get(row, [])
     
     def get_plants_by_type(self, plant_type: int) -> List[PlantInfo]:
         """Get all plants of a specific type"""
         return [p for p in self.alive_plants if p.type == plant_type]
     
     def is_cell_empty(self, row: int, col: int) -> bool:
-        """Check if a grid cell is empty"""
-        return self.get_plant_at(row, col) is None
+        """Check if a grid cell has no base plant (lily pads/pots don't count)"""
+        return self._ensure_plant_grid().is_empty(row, col)
+
+    def is_plantable(self, row: int, col: int, plant_type: int) -> bool:
+        """Check if plant_type can be placed at a grid position"""
+        return self._ensure_plant_grid().is_plantable(row, col, plant_type)
+
+    def get_plantable_cells(self, plant_type: int) -> List[tuple]:
+        """
+        Get all positions where plant_type can currently be placed
+
+        Combines plant occupancy with terrain and stacking rules via
+        the grid's per-row bitmasks; see Grid.plantable_mask()
+        """
+        return self._ensure_plant_grid().get_plantable_cells(plant_type)
     
     # ========================================================================
     # Seed Queries
@@ -347,6 +522,9 @@ class GameState:
         Returns:
             List of zombie type names (e.g., ['普通僵尸', '路障僵尸'])
         """
+        if self.wave_timeline is not None:
+            info = self.wave_timeline.wave(wave)
+            return list(info.names) if info else []
         from data.zombies import ZombieType
         types = self.get_wave_zombies(wave)
         result = []
@@ -372,6 +550,8 @@ class GameState:
         Returns:
             Dict with wave index as key and {types: [...], count: N} as value
         """
+        if self.wave_timeline is not None:
+            return self.wave_timeline.summary()
         from data.zombies import ZombieType
         summary = {}
         for wave_idx, zombies in enumerate(self.spawn_lists):
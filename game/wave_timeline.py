@@ -0,0 +1,125 @@
+"""
+Wave Timeline
+Precomputed per-level wave difficulty data derived from spawn lists
+"""
+
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional
+
+from data.zombies import (
+    ZombieType, get_zombie_total_hp, is_dangerous_zombie,
+    GARGANTUAR_ZOMBIES,
+)
+
+
+def _zombie_name(zombie_type: int) -> str:
+    try:
+        return ZombieType(zombie_type).name
+    except ValueError:
+        return f'UNKNOWN_{zombie_type}'
+
+
+@dataclass
+class WaveInfo:
+    """Aggregate data for one wave, derived from its spawn list"""
+
+    index: int  # 0-based wave index
+    zombie_types: List[int] = field(default_factory=list)
+    names: List[str] = field(default_factory=list)
+    total_hp: int = 0  # Sum of body + accessory HP over the wave
+    danger_composition: Dict[int, int] = field(default_factory=dict)  # type -> count
+    is_huge_wave: bool = False  # Flag wave (every 10th)
+
+    @property
+    def count(self) -> int:
+        return len(self.zombie_types)
+
+
+class WaveTimeline:
+    """
+    Per-level wave prediction cache
+
+    Spawn lists are rolled once at board creation, so everything
+    derivable from them is level-static: per-wave aggregate HP,
+    dangerous-zombie composition, cumulative totals and huge-wave
+    markers. Building this once per level (GameReader caches it per
+    board and attaches it by reference to every snapshot) means
+    per-tick planning does zero recomputation on static data, where
+    the planner previously re-derived names, counts and difficulty
+    from spawn_lists every tick.
+    """
+
+    def __init__(self, spawn_lists: List[List[int]]):
+        self.waves: List[WaveInfo] = []
+        self.cumulative_hp: List[int] = []  # HP of waves [0..i] inclusive
+        self.total_hp = 0
+        self.total_zombies = 0
+        self.huge_waves: List[int] = []  # 0-based indices of flag waves
+        self.first_gargantuar_wave: Optional[int] = None
+        self._summary: Optional[dict] = None
+
+        running = 0
+        for index, zombies in enumerate(spawn_lists):
+            info = WaveInfo(
+                index=index,
+                zombie_types=list(zombies),
+                names=[_zombie_name(t) for t in zombies],
+                is_huge_wave=(index + 1) % 10 == 0,
+            )
+            for z_type in zombies:
+                info.total_hp += get_zombie_total_hp(z_type)
+                if is_dangerous_zombie(z_type):
+                    info.danger_composition[z_type] = \
+                        info.danger_composition.get(z_type, 0) + 1
+                if (self.first_gargantuar_wave is None and
+                        z_type in GARGANTUAR_ZOMBIES):
+                    self.first_gargantuar_wave = index
+            running += info.total_hp
+            self.total_zombies += info.count
+            self.cumulative_hp.append(running)
+            if info.is_huge_wave:
+                self.huge_waves.append(index)
+            self.waves.append(info)
+        self.total_hp = running
+
+    def __len__(self) -> int:
+        return len(self.waves)
+
+    def wave(self, index: int) -> Optional[WaveInfo]:
+        """Get aggregate data for a wave (0-based), None if out of range"""
+        if 0 <= index < len(self.waves):
+            return self.waves[index]
+        return None
+
+    def hp_from(self, index: int) -> int:
+        """Total HP still to spawn from wave `index` (0-based) onward"""
+        if index <= 0:
+            return self.total_hp
+        if index >= len(self.waves):
+            return 0
+        return self.total_hp - self.cumulative_hp[index - 1]
+
+    def next_huge_wave(self, index: int) -> Optional[int]:
+        """First huge wave at or after `index` (0-based), None if past all"""
+        for wave in self.huge_waves:
+            if wave >= index:
+                return wave
+        return None
+
+    def summary(self) -> dict:
+        """
+        All waves as {index: {'types': names, 'count': n}}
+
+        Same shape as GameState.get_all_waves_summary(); built once and
+        reused for every snapshot sharing this timeline.
+        """
+        if self._summary is None:
+            self._summary = {
+                info.index: {'types': list(info.names), 'count': info.count}
+                for info in self.waves
+            }
+        return self._summary
+
+    def __repr__(self) -> str:
+        return (f"WaveTimeline({len(self.waves)} waves, "
+                f"{self.total_zombies} zombies, {self.total_hp} hp)")
@@ -14,7 +14,7 @@ from data.zombies import (
 )
 
 
-@dataclass
+@dataclass(slots=True)
 class ZombieInfo:
     """
     Information about a zombie on the field
@@ -1,7 +1,10 @@
 #include "bridge.h"
 #include "game.h"
+#include "snapshot.h"
 #include "state.h"
 #include <WinSock2.h>
+#include <Windows.h>
+#include <cstdlib>
 #include <sstream>
 #include <vector>
 #include <string>
@@ -13,6 +16,48 @@ namespace Bridge {
 static SOCKET g_serverSocket = INVALID_SOCKET;
 static SOCKET g_clientSocket = INVALID_SOCKET;
 static bool g_initialized = false;
+static int g_boundPort = 0;
+
+// 多开实例的端口扫描范围（基准端口起最多尝试32个）
+static constexpr int PORT_SCAN_RANGE = 32;
+
+// 锁步控制：PAUSE/RESUME/STEP命令维护的状态
+static bool g_paused = false;
+static int g_pendingSteps = 0;
+static bool g_stepReplyPending = false;
+
+// AUTOCOLLECT开关：DLL每tick自动收集掉落物
+static bool g_autoCollect = false;
+
+// RESETSTART事务状态机：进入模式→等选卡界面→选卡→开始→等板子可操作
+enum class ResetPhase { Idle, Enter, WaitChooser, Choose, Rock, WaitBoard };
+static ResetPhase g_resetPhase = ResetPhase::Idle;
+static int g_resetMode = 0;
+static int g_resetCards[10];
+static int g_resetCardCount = 0;
+static int g_resetTimeout = 0;
+
+// 事务激活期间每个宿主帧连跑的tick数（快进选卡动画）
+static constexpr int RESET_TICK_BURST = 10;
+
+// RENDER渲染门控：on每帧照常绘制；off完全跳过Board::Draw；
+// every_n每模拟n个tick绘制一帧（计数按tick走，STEP锁步burst期间
+// 中间tick不会触发绘制）
+enum class RenderMode { On, Off, EveryN };
+static RenderMode g_renderMode = RenderMode::On;
+static int g_renderEvery = 1;
+static int g_renderTickCounter = 0;
+
+// SEED固定随机种子：每次重置前写回同一种子，出怪列表和
+// 僵尸行为逐关可复现（断线自动解除）
+static bool g_seedPinned = false;
+static int g_seedValue = 0;
+
+// SUBSCRIBE订阅：每隔interval个tick主动推送一帧状态
+// 0表示未订阅；计数器跨宿主帧累积（锁步burst时也按tick数推进）
+static int g_subInterval = 0;
+static int g_subTickCounter = 0;
+static unsigned int g_subMask = State::STATE_ALL;
 
 bool Initialize(int port) {
     if (g_initialized) return true;
@@ -35,12 +80,22 @@ bool Initialize(int port) {
     ioctlsocket(g_serverSocket, FIONBIO, &mode);
     
     // 绑定端口
+    // 多开时基准端口可能已被其他实例占用，向后扫描直到找到空闲端口，
+    // 每个游戏进程自动获得独立端口
     sockaddr_in serverAddr;
     serverAddr.sin_family = AF_INET;
     serverAddr.sin_addr.s_addr = INADDR_ANY;
-    serverAddr.sin_port = htons(port);
-    
-    if (bind(g_serverSocket, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
+
+    bool bound = false;
+    for (int i = 0; i < PORT_SCAN_RANGE; ++i) {
+        serverAddr.sin_port = htons(port + i);
+        if (bind(g_serverSocket, (sockaddr*)&serverAddr, sizeof(serverAddr)) != SOCKET_ERROR) {
+            g_boundPort = port + i;
+            bound = true;
+            break;
+        }
+    }
+    if (!bound) {
         closesocket(g_serverSocket);
         WSACleanup();
         return false;
@@ -58,6 +113,8 @@ bool Initialize(int port) {
 }
 
 void Shutdown() {
+    // 卸载前恢复绘制patch
+    PVZ::SetBoardDrawEnabled(true);
     if (g_clientSocket != INVALID_SOCKET) {
         closesocket(g_clientSocket);
         g_clientSocket = INVALID_SOCKET;
@@ -105,11 +162,54 @@ static std::string ProcessCommand(const std::string& cmd) {
         return "ERR Invalid parameters\n";
     }
     else if (command == "RESET") {
+        // 重置前重新播种，MakeNewBoard内部据此生成出怪列表
+        if (g_seedPinned) {
+            PVZ::SetRandSeed(g_seedValue);
+        }
         if (PVZ::MakeNewBoard()) {
             return "OK\n";
         }
         return "ERR Failed to reset\n";
     }
+    else if (command == "RENDER") {
+        // RENDER on|off|<n> 渲染门控，训练时跳过绘制换吞吐
+        std::string arg;
+        if (!(iss >> arg)) {
+            return "ERR Invalid parameters\n";
+        }
+        if (arg == "on" || arg == "ON") {
+            g_renderMode = RenderMode::On;
+            PVZ::SetBoardDrawEnabled(true);
+            return "OK\n";
+        }
+        if (arg == "off" || arg == "OFF") {
+            g_renderMode = RenderMode::Off;
+            PVZ::SetBoardDrawEnabled(false);
+            return "OK\n";
+        }
+        int every = std::atoi(arg.c_str());
+        if (every < 1) {
+            return "ERR Invalid parameters\n";
+        }
+        g_renderMode = RenderMode::EveryN;
+        g_renderEvery = every;
+        g_renderTickCounter = 0;
+        return "OK\n";
+    }
+    else if (command == "SEED") {
+        // SEED value 固定随机种子 / SEED off 恢复随机
+        std::string arg;
+        if (!(iss >> arg)) {
+            return "ERR Invalid parameters\n";
+        }
+        if (arg == "off" || arg == "OFF") {
+            g_seedPinned = false;
+            return "OK\n";
+        }
+        g_seedValue = std::atoi(arg.c_str());
+        g_seedPinned = true;
+        return "OK\n";
+    }
     else if (command == "ENTER") {
         int mode;
         if (iss >> mode) {
@@ -144,7 +244,172 @@ static std::string ProcessCommand(const std::string& cmd) {
         std::string state = State::GetGameState();
         return state + "\n";
     }
-    
+    else if (command == "STATEB") {
+        // v2二进制状态帧（帧头自带长度，不加换行）
+        // 可选字段掩码：STATEB [mask]，只序列化掩码选中的实体段
+        unsigned int mask = State::STATE_ALL;
+        unsigned int parsed;
+        if (iss >> parsed) mask = parsed;
+        std::vector<char> frame;
+        State::GetGameStateBinary(frame, State::FRAME_TYPE_STATE, mask);
+        return std::string(frame.begin(), frame.end());
+    }
+    else if (command == "BATCH") {
+        // 批量执行：BATCH cmd1;cmd2;...
+        // 所有子命令在同一帧内依次执行，对游戏时间而言是原子的
+        std::string rest;
+        std::getline(iss, rest);
+        if (!rest.empty() && rest[0] == ' ') {
+            rest.erase(0, 1);
+        }
+
+        std::string results;
+        size_t start = 0;
+        while (start <= rest.size()) {
+            size_t end = rest.find(';', start);
+            if (end == std::string::npos) end = rest.size();
+            std::string sub = rest.substr(start, end - start);
+            start = end + 1;
+            if (sub.empty()) continue;
+
+            std::string response = ProcessCommand(sub);
+            if (!results.empty()) results += ',';
+            results += (response.compare(0, 2, "OK") == 0) ? '1' : '0';
+        }
+
+        return "OK " + results + "\n";
+    }
+    else if (command == "COLLECT") {
+        // 单次收集全部掉落物，返回收集数
+        int count = PVZ::CollectAllItems();
+        return "OK " + std::to_string(count) + "\n";
+    }
+    else if (command == "AUTOCOLLECT") {
+        // AUTOCOLLECT on|off：DLL每tick自动收集，客户端零流量
+        std::string arg;
+        iss >> arg;
+        if (arg == "on") {
+            g_autoCollect = true;
+            return "OK\n";
+        }
+        if (arg == "off") {
+            g_autoCollect = false;
+            return "OK\n";
+        }
+        return "ERR Invalid parameters\n";
+    }
+    else if (command == "PAUSE") {
+        // 暂停游戏逻辑（Hook仍每帧运行，继续接收命令）
+        g_paused = true;
+        return "OK\n";
+    }
+    else if (command == "RESUME") {
+        g_paused = false;
+        g_pendingSteps = 0;
+        return "OK\n";
+    }
+    else if (command == "STEP") {
+        // 锁步推进：暂停状态下精确执行n个tick，
+        // 响应延迟到tick跑完后发送（二进制状态帧，见NotifyTicksDone）
+        int n = 1;
+        iss >> n;
+        if (n <= 0) {
+            return "ERR Invalid parameters\n";
+        }
+        g_paused = true;
+        g_pendingSteps = n;
+        g_stepReplyPending = true;
+        return "";  // 空响应表示延迟回复
+    }
+    else if (command == "SUBSCRIBE") {
+        // 事件推送模式：SUBSCRIBE interval_ticks [mask]
+        // 每interval个tick主动推送一帧二进制状态（推送帧类型，
+        // 客户端与请求响应帧区分），免去请求腿的往返延迟
+        int interval;
+        if (!(iss >> interval) || interval <= 0) {
+            return "ERR Invalid parameters\n";
+        }
+        unsigned int mask = State::STATE_ALL;
+        unsigned int parsed;
+        if (iss >> parsed) mask = parsed;
+        g_subInterval = interval;
+        g_subMask = mask;
+        g_subTickCounter = 0;
+        return "OK\n";
+    }
+    else if (command == "UNSUBSCRIBE") {
+        g_subInterval = 0;
+        g_subTickCounter = 0;
+        return "OK\n";
+    }
+    else if (command == "SAVESTATE") {
+        // 保存当前Board快照到进程内缓冲区（rollout搜索/中段重启）
+        int id;
+        if (!(iss >> id)) {
+            return "ERR Invalid parameters\n";
+        }
+        if (Snapshot::Save(id)) {
+            return "OK\n";
+        }
+        return "ERR Not in game\n";
+    }
+    else if (command == "LOADSTATE") {
+        // 恢复快照；Board已重建（重进关卡）时快照失效
+        int id;
+        if (!(iss >> id)) {
+            return "ERR Invalid parameters\n";
+        }
+        if (Snapshot::Load(id)) {
+            return "OK\n";
+        }
+        return "ERR No such snapshot or board changed\n";
+    }
+    else if (command == "DROPSTATE") {
+        // 删除快照释放内存
+        int id;
+        if (!(iss >> id)) {
+            return "ERR Invalid parameters\n";
+        }
+        if (Snapshot::Drop(id)) {
+            return "OK\n";
+        }
+        return "ERR No such snapshot\n";
+    }
+    else if (command == "RESETSTART") {
+        // 快速重置事务：RESETSTART mode card1,card2,...
+        // 状态机在游戏线程上逐帧推进（进入模式→选卡→开始），
+        // 板子可操作后才回复（开局后的二进制状态帧，同STEP的延迟回复）
+        int mode;
+        if (!(iss >> mode)) {
+            return "ERR Invalid parameters\n";
+        }
+        g_resetCardCount = 0;
+        std::string cards;
+        if (iss >> cards) {
+            std::istringstream cardStream(cards);
+            std::string item;
+            while (std::getline(cardStream, item, ',') &&
+                   g_resetCardCount < (int)(sizeof(g_resetCards) / sizeof(int))) {
+                if (!item.empty()) {
+                    g_resetCards[g_resetCardCount++] = std::atoi(item.c_str());
+                }
+            }
+        }
+        g_resetMode = mode;
+        g_resetPhase = ResetPhase::Enter;
+        g_resetTimeout = 600;  // 宿主帧上限，防止界面卡住时事务永不结束
+        return "";  // 空响应表示延迟回复
+    }
+    else if (command == "HELLO") {
+        // 协议协商：返回双方都支持的最高版本和本进程PID
+        // （PID用于定位共享内存状态通道）
+        int requested = 1;
+        iss >> requested;
+        int version = requested >= 2 ? 2 : 1;
+        return "OK " + std::to_string(version) + " " +
+               std::to_string(GetCurrentProcessId()) + "\n";
+    }
+
     return "ERR Unknown command\n";
 }
 
@@ -183,8 +448,29 @@ void ProcessCommands() {
                 }
                 
                 if (!cmd.empty()) {
+                    // 请求标签："#<id> CMD ..."，文本响应原样回带标签，
+                    // 异步客户端据此在单连接上并发多个在途请求
+                    std::string tag;
+                    if (cmd[0] == '#') {
+                        size_t space = cmd.find(' ');
+                        if (space != std::string::npos) {
+                            tag = cmd.substr(0, space);
+                            cmd.erase(0, space + 1);
+                        }
+                    }
+
+                    // data()/length()以支持含\0的二进制响应帧
                     std::string response = ProcessCommand(cmd);
-                    send(g_clientSocket, response.c_str(), response.length(), 0);
+                    if (!response.empty()) {
+                        // 二进制帧（以'P'开头的magic）不加标签，按序匹配
+                        bool isText = response.compare(0, 2, "OK") == 0 ||
+                                      response.compare(0, 3, "ERR") == 0 ||
+                                      response[0] == '{';
+                        if (!tag.empty() && isText) {
+                            response = tag + " " + response;
+                        }
+                        send(g_clientSocket, response.data(), (int)response.length(), 0);
+                    }
                 }
             }
         }
@@ -192,6 +478,140 @@ void ProcessCommands() {
             // 客户端断开连接
             closesocket(g_clientSocket);
             g_clientSocket = INVALID_SOCKET;
+            // 避免断线后残留暂停状态卡死游戏
+            g_paused = false;
+            g_pendingSteps = 0;
+            g_stepReplyPending = false;
+            g_resetPhase = ResetPhase::Idle;
+            g_subInterval = 0;
+            g_subTickCounter = 0;
+            g_seedPinned = false;
+            g_renderMode = RenderMode::On;
+            PVZ::SetBoardDrawEnabled(true);
+            // 快照占内存可观（每份约1MB），断线即释放
+            Snapshot::Clear();
+        }
+    }
+}
+
+int TicksToRun() {
+    if (g_pendingSteps > 0) {
+        int n = g_pendingSteps;
+        g_pendingSteps = 0;
+        return n;
+    }
+    // 重置事务期间连跑多个tick快进选卡动画，暂停状态不阻塞事务
+    if (g_resetPhase != ResetPhase::Idle) {
+        return RESET_TICK_BURST;
+    }
+    return g_paused ? 0 : 1;
+}
+
+static void SendErrorFrame(const std::string& message) {
+    if (g_clientSocket == INVALID_SOCKET) return;
+    std::vector<char> frame;
+    State::BuildErrorFrame(frame, message);
+    send(g_clientSocket, frame.data(), (int)frame.size(), 0);
+}
+
+void UpdateRenderGate(int ticksThisFrame) {
+    if (g_renderMode != RenderMode::EveryN) return;
+    // 绘制发生在宿主帧返回之后：本帧跑满n个tick就放行一次绘制
+    g_renderTickCounter += ticksThisFrame;
+    if (g_renderTickCounter >= g_renderEvery) {
+        g_renderTickCounter %= g_renderEvery;
+        PVZ::SetBoardDrawEnabled(true);
+    }
+    else {
+        PVZ::SetBoardDrawEnabled(false);
+    }
+}
+
+void AdvanceReset() {
+    if (g_resetPhase == ResetPhase::Idle) return;
+
+    if (--g_resetTimeout <= 0) {
+        g_resetPhase = ResetPhase::Idle;
+        // 客户端在等v2二进制帧，文本ERR会被当作帧头解析导致流失步
+        SendErrorFrame("Reset timeout");
+        return;
+    }
+
+    switch (g_resetPhase) {
+    case ResetPhase::Enter:
+        // 固定种子要在建板前写入：EnterGame里mBoardRandSeed = Rand()，
+        // 选卡界面的出怪预览已经由它决定
+        if (g_seedPinned) {
+            PVZ::SetRandSeed(g_seedValue);
+        }
+        // 从任意界面直接预载目标模式（主菜单/游戏中均可）
+        if (PVZ::EnterGame(g_resetMode)) {
+            g_resetPhase = ResetPhase::WaitChooser;
+        }
+        break;
+
+    case ResetPhase::WaitChooser:
+        if (PVZ::GetGameUI() == 2) {
+            g_resetPhase = ResetPhase::Choose;
+        }
+        else if (PVZ::IsInGame() && g_resetCardCount == 0) {
+            // 无选卡界面的模式（如泳池关卡外的小游戏）直接进场
+            g_resetPhase = ResetPhase::WaitBoard;
+        }
+        break;
+
+    case ResetPhase::Choose:
+        // 选卡界面内一帧选完全部卡片
+        for (int i = 0; i < g_resetCardCount; ++i) {
+            PVZ::ChooseCard(g_resetCards[i]);
+        }
+        g_resetPhase = ResetPhase::Rock;
+        break;
+
+    case ResetPhase::Rock:
+        // 卡片飞入动画未结束时Rock可能无效，逐帧重试
+        if (PVZ::Rock()) {
+            g_resetPhase = ResetPhase::WaitBoard;
+        }
+        break;
+
+    case ResetPhase::WaitBoard:
+        if (PVZ::IsInGame() && PVZ::GetBoard()) {
+            g_resetPhase = ResetPhase::Idle;
+            // 板子已可操作，回复开局后的状态帧
+            g_stepReplyPending = true;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool AutoCollectEnabled() {
+    return g_autoCollect;
+}
+
+void NotifyTicksDone(int ticksRun) {
+    if (g_clientSocket == INVALID_SOCKET) return;
+
+    // STEP的延迟回复：步进后的状态帧
+    if (g_stepReplyPending) {
+        g_stepReplyPending = false;
+        std::vector<char> frame;
+        State::GetGameStateBinary(frame);
+        send(g_clientSocket, frame.data(), (int)frame.size(), 0);
+    }
+
+    // 订阅推送：每满interval个tick推一帧（推送帧类型）
+    // 一个宿主帧连跑多tick时也只推最新一帧，不补发中间帧
+    if (g_subInterval > 0 && ticksRun > 0) {
+        g_subTickCounter += ticksRun;
+        if (g_subTickCounter >= g_subInterval) {
+            g_subTickCounter %= g_subInterval;
+            std::vector<char> frame;
+            State::GetGameStateBinary(frame, State::FRAME_TYPE_PUSH, g_subMask);
+            send(g_clientSocket, frame.data(), (int)frame.size(), 0);
         }
     }
 }
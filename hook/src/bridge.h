@@ -8,6 +8,7 @@
 namespace Bridge {
 
 // 初始化TCP服务器
+// 端口被占用时（多开）从port起向后扫描空闲端口
 bool Initialize(int port = 12345);
 
 // 关闭服务器
@@ -16,6 +17,26 @@ void Shutdown();
 // 处理一帧的命令（非阻塞）
 void ProcessCommands();
 
+// 查询本帧应执行的游戏tick数
+// 正常运行返回1；PAUSE后返回0；STEP n后一次性返回剩余步数
+// （在同一宿主帧内连跑n个tick，步进速度只受CPU限制）
+int TicksToRun();
+
+// tick执行完毕后调用（ticksRun为本帧实际执行的tick数）：
+// 发送待回复的STEP响应帧，并按SUBSCRIBE间隔推送订阅状态帧
+void NotifyTicksDone(int ticksRun);
+
+// AUTOCOLLECT开关是否打开（每tick自动收集掉落物）
+bool AutoCollectEnabled();
+
+// RENDER every_n门控：按本帧tick数推进计数器，决定帧返回后
+// 是否放行Board::Draw（on/off模式下为空操作）
+void UpdateRenderGate(int ticksThisFrame);
+
+// 每帧推进RESETSTART事务状态机（进入模式→选卡→开始→等板子）
+// 事务完成或超时前不发送响应；完成后经NotifyTicksDone回复状态帧
+void AdvanceReset();
+
 // 命令处理结果
 struct CommandResult {
     bool success;
@@ -1,6 +1,7 @@
 #include <Windows.h>
 #include "bridge.h"
 #include "game.h"
+#include "shm.h"
 
 // Hook相关
 static BYTE g_originalBytes[5];
@@ -15,11 +16,31 @@ static GameLoopFunc g_originalGameLoop = nullptr;
 void __cdecl HookedGameLoop() {
     // 处理Python命令
     Bridge::ProcessCommands();
-    
+
+    // 推进RESETSTART快速重置事务（如有）
+    Bridge::AdvanceReset();
+
     // 调用原始游戏循环
-    if (g_originalGameLoop) {
+    // 锁步模式下由Bridge决定tick数：暂停时0，STEP n时在本帧连跑n个tick
+    int ticks = Bridge::TicksToRun();
+
+    // RENDER every_n：按本帧tick数决定返回后是否绘制
+    Bridge::UpdateRenderGate(ticks);
+
+    for (int i = 0; i < ticks && g_originalGameLoop; ++i) {
         g_originalGameLoop();
+
+        // 每tick自动收集掉落物（AUTOCOLLECT on时），客户端零流量
+        if (Bridge::AutoCollectEnabled() && PVZ::IsInGame()) {
+            PVZ::CollectAllItems();
+        }
     }
+
+    // STEP执行完毕后发送延迟响应，并推送订阅状态帧
+    Bridge::NotifyTicksDone(ticks);
+
+    // 发布本帧结束后的状态到共享内存
+    Shm::Publish();
 }
 
 bool InstallHook() {
@@ -72,14 +93,17 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReason, LPVOID lpReserved) {
         
         // 初始化TCP服务器
         if (Bridge::Initialize(12345)) {
+            // 共享内存状态通道（失败不影响TCP路径）
+            Shm::Initialize();
             // 安装Hook
             InstallHook();
         }
         break;
-        
+
     case DLL_PROCESS_DETACH:
         // DLL被卸载
         UninstallHook();
+        Shm::Shutdown();
         Bridge::Shutdown();
         break;
     }
@@ -23,10 +23,24 @@ namespace Addr {
     constexpr uintptr_t PLANT_ARRAY = 0xAC;
     constexpr uintptr_t PLANT_COUNT_MAX = 0xB0;
     constexpr uintptr_t PLANT_SIZE = 0x14C;
+    constexpr uintptr_t ITEM_ARRAY = 0xE4;
+    constexpr uintptr_t ITEM_COUNT_MAX = 0xE8;
+    constexpr uintptr_t ITEM_SIZE = 0xD8;
+    constexpr uintptr_t I_DISAPPEARED = 0x38;
+    constexpr uintptr_t I_COLLECTED = 0x50;
     constexpr uintptr_t P_ROW = 0x1C;
     constexpr uintptr_t P_COL = 0x28;
     constexpr uintptr_t P_DEAD = 0x141;
     constexpr uintptr_t SEED_CHOOSER = 0x774;
+
+    // Board::Draw(Sexy::Graphics*)，每帧的棋盘渲染入口。
+    // 训练时把入口patch成ret 4即可跳过整个绘制路径，模拟不受影响
+    constexpr uintptr_t FUNC_BOARD_DRAW = 0x415D40;
+
+    // Sexy::gRandSeed，Rand()的LCG状态（内存表标注"随机数种子"）。
+    // 建板时mBoardRandSeed = Rand()，出怪列表由它播种，所以在
+    // EnterGame/MakeNewBoard之前写入即可固定整关的随机序列
+    constexpr uintptr_t RAND_SEED = 0x6A623C;
 }
 
 namespace PVZ {
@@ -247,4 +261,61 @@ bool BackToMain() {
     return true;
 }
 
+int CollectAllItems() {
+    uintptr_t board = GetBoard();
+    if (!board) return 0;
+
+    uintptr_t itemArray = *(uintptr_t*)(board + Addr::ITEM_ARRAY);
+    int itemMax = *(int*)(board + Addr::ITEM_COUNT_MAX);
+    if (!itemArray || itemMax <= 0) return 0;
+    if (itemMax > 100) itemMax = 100;
+
+    // 进程内遍历，置collected标志后游戏自行播放收集动画并计入阳光
+    int count = 0;
+    for (int i = 0; i < itemMax; ++i) {
+        uintptr_t item = itemArray + i * Addr::ITEM_SIZE;
+        if (*(uint8_t*)(item + Addr::I_DISAPPEARED)) continue;
+        if (*(uint8_t*)(item + Addr::I_COLLECTED)) continue;
+        *(uint8_t*)(item + Addr::I_COLLECTED) = 1;
+        ++count;
+    }
+    return count;
+}
+
+// Board::Draw入口的原始字节（patch成ret 4后用于恢复）
+static BYTE g_drawOriginal[3];
+static bool g_drawPatched = false;
+
+void SetBoardDrawEnabled(bool enabled) {
+    if (enabled == !g_drawPatched) return;
+
+    DWORD oldProtect;
+    VirtualProtect((void*)Addr::FUNC_BOARD_DRAW, 3,
+                   PAGE_EXECUTE_READWRITE, &oldProtect);
+    if (enabled) {
+        memcpy((void*)Addr::FUNC_BOARD_DRAW, g_drawOriginal, 3);
+        g_drawPatched = false;
+    }
+    else {
+        memcpy(g_drawOriginal, (void*)Addr::FUNC_BOARD_DRAW, 3);
+        // thiscall带一个栈参数：ret 4
+        static const BYTE ret4[3] = { 0xC2, 0x04, 0x00 };
+        memcpy((void*)Addr::FUNC_BOARD_DRAW, ret4, 3);
+        g_drawPatched = true;
+    }
+    VirtualProtect((void*)Addr::FUNC_BOARD_DRAW, 3, oldProtect, &oldProtect);
+}
+
+bool GetBoardDrawEnabled() {
+    return !g_drawPatched;
+}
+
+void SetRandSeed(int seed) {
+    *(int*)Addr::RAND_SEED = seed;
+}
+
+int GetRandSeed() {
+    return *(int*)Addr::RAND_SEED;
+}
+
 }  // namespace PVZ
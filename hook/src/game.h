@@ -28,5 +28,14 @@ bool Rock();                                // 开始游戏（点击Let's Rock
 bool MakeNewBoard();                        // 重置关卡
 bool EnterGame(int mode);                   // 进入游戏模式
 bool BackToMain();                          // 返回主菜单
+int CollectAllItems();                      // 收集全部掉落物，返回本次收集数
+
+// 随机数种子（Sexy::Rand的LCG状态）
+void SetRandSeed(int seed);                 // 写入全局随机种子
+int GetRandSeed();                          // 读取全局随机种子
+
+// 渲染开关（patch Board::Draw入口，关闭后模拟照常推进）
+void SetBoardDrawEnabled(bool enabled);
+bool GetBoardDrawEnabled();
 
 }  // namespace PVZ
@@ -0,0 +1,98 @@
+#include "shm.h"
+#include "state.h"
+#include <Windows.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t SHM_MAGIC = 0x535A5650;  // 'PVZS' little-endian
+constexpr uint32_t SHM_VERSION = 1;
+constexpr uint32_t HEADER_SIZE = 64;        // 头部预留（当前用32字节）
+constexpr uint32_t BUFFER_SIZE = 64 * 1024; // 每个缓冲区容量
+
+#pragma pack(push, 1)
+struct ShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t buffer_size;
+    volatile uint32_t active_index;  // 当前稳定缓冲区(0/1)
+    volatile uint32_t seq[2];        // 序列锁：奇数=写入中，偶数=稳定
+    uint32_t frame_len[2];           // 各缓冲区内帧长度
+};
+#pragma pack(pop)
+
+HANDLE g_mapping = nullptr;
+ShmHeader* g_header = nullptr;
+char* g_buffers[2] = {nullptr, nullptr};
+std::vector<char> g_scratch;
+
+}  // namespace
+
+namespace Shm {
+
+bool Initialize() {
+    if (g_mapping) return true;
+
+    char name[64];
+    sprintf_s(name, "Local\\pvz_hook_state_%lu", GetCurrentProcessId());
+
+    uint32_t totalSize = HEADER_SIZE + 2 * BUFFER_SIZE;
+    g_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr,
+                                   PAGE_READWRITE, 0, totalSize, name);
+    if (!g_mapping) return false;
+
+    void* view = MapViewOfFile(g_mapping, FILE_MAP_ALL_ACCESS, 0, 0, totalSize);
+    if (!view) {
+        CloseHandle(g_mapping);
+        g_mapping = nullptr;
+        return false;
+    }
+
+    memset(view, 0, HEADER_SIZE);
+    g_header = (ShmHeader*)view;
+    g_buffers[0] = (char*)view + HEADER_SIZE;
+    g_buffers[1] = (char*)view + HEADER_SIZE + BUFFER_SIZE;
+
+    g_header->version = SHM_VERSION;
+    g_header->buffer_size = BUFFER_SIZE;
+    g_header->active_index = 0;
+    // magic最后写入，读端以此判断通道就绪
+    MemoryBarrier();
+    g_header->magic = SHM_MAGIC;
+    return true;
+}
+
+void Publish() {
+    if (!g_header) return;
+
+    State::GetGameStateBinary(g_scratch);
+    if (g_scratch.size() > BUFFER_SIZE) return;  // 超限帧丢弃
+
+    // 写入非活动缓冲区，序列锁标记写入窗口，完成后翻转活动位
+    uint32_t idx = 1 - g_header->active_index;
+    g_header->seq[idx]++;  // 奇数：写入中
+    MemoryBarrier();
+    memcpy(g_buffers[idx], g_scratch.data(), g_scratch.size());
+    g_header->frame_len[idx] = (uint32_t)g_scratch.size();
+    MemoryBarrier();
+    g_header->seq[idx]++;  // 偶数：稳定
+    g_header->active_index = idx;
+}
+
+void Shutdown() {
+    if (g_header) {
+        g_header->magic = 0;
+        UnmapViewOfFile((void*)g_header);
+        g_header = nullptr;
+        g_buffers[0] = g_buffers[1] = nullptr;
+    }
+    if (g_mapping) {
+        CloseHandle(g_mapping);
+        g_mapping = nullptr;
+    }
+}
+
+}  // namespace Shm
@@ -0,0 +1,19 @@
+#pragma once
+
+// 共享内存状态通道
+// 每帧将v2二进制状态帧发布到命名共享内存（双缓冲+序列锁），
+// 同主机的Python端可零拷贝读取最新快照，无需走TCP。
+// 布局见hook_client/shared_memory.py
+
+namespace Shm {
+
+// 创建命名共享内存（名称含当前进程PID）
+bool Initialize();
+
+// 发布当前游戏状态（每帧在游戏线程调用）
+void Publish();
+
+// 释放共享内存
+void Shutdown();
+
+}  // namespace Shm
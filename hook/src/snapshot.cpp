@@ -0,0 +1,92 @@
+#include "snapshot.h"
+#include "game.h"
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace Snapshot {
+
+// Board结构体大小（1.0.0.1051版，参考AVZ）
+// 种子栏（SeedBank，board+0x144）内联在Board中，随结构体一起复制
+static constexpr size_t BOARD_SIZE = 0x57B0;
+
+// 实体数组描述：Board内的数组指针偏移 + 元素大小 + 分配容量
+// DataArray的backing store按容量整块分配，整块复制可以连同
+// 空闲链表一起还原，不必关心存活数
+struct ArrayDesc {
+    uintptr_t ptrOffset;   // Board内数组指针的偏移
+    size_t elemSize;       // 单个元素大小
+    size_t capacity;       // 分配容量（固定，随Board创建）
+};
+
+static constexpr ArrayDesc ARRAYS[] = {
+    { 0x90,  0x15C, 1024 },  // 僵尸
+    { 0xAC,  0x14C, 1024 },  // 植物
+    { 0xC8,  0x94,  1024 },  // 子弹
+    { 0xE4,  0xD8,  1024 },  // 掉落物
+    { 0x100, 0x48,  32   },  // 小车
+    { 0x11C, 0xEC,  128  },  // 场地物件（墓碑、弹坑等）
+};
+static constexpr int ARRAY_COUNT = sizeof(ARRAYS) / sizeof(ARRAYS[0]);
+
+// 一份快照：Board结构体 + 各实体数组的完整backing store
+struct BoardSnapshot {
+    uintptr_t board;                          // 来源Board指针（恢复时校验）
+    std::vector<char> boardData;
+    std::vector<char> arrayData[ARRAY_COUNT];
+};
+
+static std::map<int, BoardSnapshot> g_snapshots;
+
+bool Save(int id) {
+    uintptr_t board = PVZ::GetBoard();
+    if (!board || !PVZ::IsInGame()) return false;
+
+    BoardSnapshot& snap = g_snapshots[id];
+    snap.board = board;
+    snap.boardData.resize(BOARD_SIZE);
+    std::memcpy(snap.boardData.data(), (void*)board, BOARD_SIZE);
+
+    for (int i = 0; i < ARRAY_COUNT; ++i) {
+        uintptr_t data = *(uintptr_t*)(board + ARRAYS[i].ptrOffset);
+        size_t bytes = ARRAYS[i].elemSize * ARRAYS[i].capacity;
+        snap.arrayData[i].resize(bytes);
+        if (data) {
+            std::memcpy(snap.arrayData[i].data(), (void*)data, bytes);
+        }
+    }
+    return true;
+}
+
+bool Load(int id) {
+    auto it = g_snapshots.find(id);
+    if (it == g_snapshots.end()) return false;
+
+    uintptr_t board = PVZ::GetBoard();
+    // 快照只能恢复到来源Board实例：Board重建后数组指针已变，
+    // 旧快照里的指针会指向已释放的内存
+    if (!board || board != it->second.board) return false;
+
+    const BoardSnapshot& snap = it->second;
+    // 先还原数组再还原Board结构体，恢复过程对游戏逻辑原子
+    // （在游戏线程的命令处理阶段执行，期间不会跑tick）
+    for (int i = 0; i < ARRAY_COUNT; ++i) {
+        uintptr_t data = *(uintptr_t*)(board + ARRAYS[i].ptrOffset);
+        if (data) {
+            std::memcpy((void*)data, snap.arrayData[i].data(),
+                        snap.arrayData[i].size());
+        }
+    }
+    std::memcpy((void*)board, snap.boardData.data(), BOARD_SIZE);
+    return true;
+}
+
+bool Drop(int id) {
+    return g_snapshots.erase(id) > 0;
+}
+
+void Clear() {
+    g_snapshots.clear();
+}
+
+}  // namespace Snapshot
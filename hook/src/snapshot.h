@@ -0,0 +1,24 @@
+#pragma once
+
+// Board快照：保存/恢复整个关卡状态
+// 用于MCTS类rollout搜索和从关卡中段快速重启训练
+
+namespace Snapshot {
+
+// 保存当前Board到进程内缓冲区（按id索引，重复保存覆盖）
+// 复制Board结构体（含阳光、时钟、波数、RNG、种子栏）
+// 及全部实体数组（僵尸/植物/子弹/掉落物/小车/场地物件）
+bool Save(int id);
+
+// 恢复id对应的快照，单tick内完成
+// 仅在快照来源的同一个Board实例上有效：实体数组的指针
+// 随Board一起恢复，重新进关后数组已重新分配，快照即失效
+bool Load(int id);
+
+// 删除指定快照，释放缓冲区；id不存在返回false
+bool Drop(int id);
+
+// 清空全部快照（断线/重进关卡时调用）
+void Clear();
+
+}  // namespace Snapshot
@@ -1,8 +1,140 @@
 #include "state.h"
 #include "game.h"
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 
+namespace {
+
+// v2二进制协议（与hook_client/protocol.py严格一致）
+constexpr uint32_t FRAME_MAGIC = 0x325A5650;  // 'PVZ2' little-endian
+
+#pragma pack(push, 1)
+
+struct FrameHeader {
+    uint32_t magic;
+    uint32_t length;  // payload长度
+    uint8_t type;
+};
+
+struct StateHeader {
+    int32_t sun;
+    int32_t wave;
+    int32_t total_waves;
+    int32_t scene;
+    int32_t game_clock;
+    int32_t in_game;
+    uint16_t zombie_count;
+    uint16_t plant_count;
+    uint16_t seed_count;
+    uint16_t pad;
+};
+
+struct ZombieRecord {
+    int32_t index;
+    int32_t row;
+    int32_t type;
+    float x;
+    float y;
+    int32_t hp;
+    int32_t hp_max;
+    int32_t accessory_hp;
+    int32_t state;
+    float speed;
+    int32_t slow_countdown;
+    int32_t freeze_countdown;
+    int32_t butter_countdown;
+    int32_t at_wave;
+};
+
+struct PlantRecord {
+    int32_t index;
+    int32_t row;
+    int32_t col;
+    int32_t type;
+    int32_t hp;
+    int32_t hp_max;
+    int32_t state;
+    int32_t shoot_countdown;
+    int32_t effective;
+    int32_t pumpkin_hp;
+    int32_t cob_countdown;
+    int32_t cob_ready;
+};
+
+struct SeedRecord {
+    int32_t index;
+    int32_t type;
+    int32_t recharge_countdown;
+    int32_t recharge_time;
+    int32_t usable;
+    int32_t imitator_type;
+};
+
+#pragma pack(pop)
+
+// 实体结构偏移（参考data/offsets.py）
+namespace Off {
+    constexpr uintptr_t ZOMBIE_ARRAY = 0x90;
+    constexpr uintptr_t ZOMBIE_COUNT_MAX = 0x94;
+    constexpr uintptr_t ZOMBIE_SIZE = 0x15C;
+    constexpr uintptr_t Z_ROW = 0x1C;
+    constexpr uintptr_t Z_TYPE = 0x24;
+    constexpr uintptr_t Z_STATE = 0x28;
+    constexpr uintptr_t Z_X = 0x2C;
+    constexpr uintptr_t Z_Y = 0x30;
+    constexpr uintptr_t Z_SPEED = 0x34;
+    constexpr uintptr_t Z_AT_WAVE = 0x6C;
+    constexpr uintptr_t Z_SLOW = 0xAC;
+    constexpr uintptr_t Z_BUTTER = 0xB0;
+    constexpr uintptr_t Z_FREEZE = 0xB4;
+    constexpr uintptr_t Z_HP = 0xC8;
+    constexpr uintptr_t Z_HP_MAX = 0xCC;
+    constexpr uintptr_t Z_ACCESSORY_HP = 0xD0;
+    constexpr uintptr_t Z_DEAD = 0xEC;
+
+    constexpr uintptr_t PLANT_ARRAY = 0xAC;
+    constexpr uintptr_t PLANT_COUNT_MAX = 0xB0;
+    constexpr uintptr_t PLANT_SIZE = 0x14C;
+    constexpr uintptr_t P_ROW = 0x1C;
+    constexpr uintptr_t P_TYPE = 0x24;
+    constexpr uintptr_t P_COL = 0x28;
+    constexpr uintptr_t P_STATE = 0x3C;
+    constexpr uintptr_t P_HP = 0x40;
+    constexpr uintptr_t P_HP_MAX = 0x44;
+    constexpr uintptr_t P_EFFECTIVE = 0x48;
+    constexpr uintptr_t P_PUMPKIN_HP = 0x4C;
+    constexpr uintptr_t P_COB_COUNTDOWN = 0x54;
+    constexpr uintptr_t P_COB_READY = 0x58;
+    constexpr uintptr_t P_SHOOT_COUNTDOWN = 0x90;
+    constexpr uintptr_t P_DEAD = 0x141;
+
+    constexpr uintptr_t SEED_ARRAY = 0x144;
+    constexpr uintptr_t SEED_SIZE = 0x50;
+    constexpr uintptr_t S_RECHARGE_COUNTDOWN = 0x4C;
+    constexpr uintptr_t S_RECHARGE_TIME = 0x50;
+    constexpr uintptr_t S_TYPE = 0x5C;
+    constexpr uintptr_t S_IMITATOR_TYPE = 0x60;
+    constexpr uintptr_t S_USABLE = 0x70;
+
+    constexpr uintptr_t TOTAL_WAVE = 0x5564;
+    constexpr uintptr_t GAME_CLOCK = 0x5568;
+}
+
+template <typename T>
+T Read(uintptr_t addr) {
+    return *(T*)addr;
+}
+
+template <typename T>
+void Append(std::vector<char>& out, const T& value) {
+    const char* p = (const char*)&value;
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+}  // namespace
+
 namespace State {
 
 std::string GetGameState() {
@@ -73,4 +205,116 @@ std::string GetGameState() {
     return oss.str();
 }
 
+void GetGameStateBinary(std::vector<char>& out, unsigned char frameType,
+                        unsigned int mask) {
+    out.clear();
+
+    StateHeader header = {};
+    header.sun = PVZ::GetSun();
+    header.wave = PVZ::GetWave();
+    header.scene = PVZ::GetScene();
+    header.in_game = PVZ::IsInGame() ? 1 : 0;
+
+    std::vector<char> body;
+    uintptr_t board = PVZ::GetBoard();
+    if (board) {
+        header.total_waves = Read<int>(board + Off::TOTAL_WAVE);
+        header.game_clock = Read<int>(board + Off::GAME_CLOCK);
+
+        // 僵尸记录
+        uintptr_t zombieArray = Read<uintptr_t>(board + Off::ZOMBIE_ARRAY);
+        int zombieMax = Read<int>(board + Off::ZOMBIE_COUNT_MAX);
+        if ((mask & STATE_ZOMBIES) &&
+            zombieArray && zombieMax > 0 && zombieMax <= 200) {
+            for (int i = 0; i < zombieMax; i++) {
+                uintptr_t addr = zombieArray + i * Off::ZOMBIE_SIZE;
+                if (Read<bool>(addr + Off::Z_DEAD)) continue;
+
+                ZombieRecord rec = {};
+                rec.index = i;
+                rec.row = Read<int>(addr + Off::Z_ROW);
+                rec.type = Read<int>(addr + Off::Z_TYPE);
+                rec.x = Read<float>(addr + Off::Z_X);
+                rec.y = Read<float>(addr + Off::Z_Y);
+                rec.hp = Read<int>(addr + Off::Z_HP);
+                rec.hp_max = Read<int>(addr + Off::Z_HP_MAX);
+                rec.accessory_hp = Read<int>(addr + Off::Z_ACCESSORY_HP);
+                rec.state = Read<int>(addr + Off::Z_STATE);
+                rec.speed = Read<float>(addr + Off::Z_SPEED);
+                rec.slow_countdown = Read<int>(addr + Off::Z_SLOW);
+                rec.freeze_countdown = Read<int>(addr + Off::Z_FREEZE);
+                rec.butter_countdown = Read<int>(addr + Off::Z_BUTTER);
+                rec.at_wave = Read<int>(addr + Off::Z_AT_WAVE);
+                Append(body, rec);
+                header.zombie_count++;
+            }
+        }
+
+        // 植物记录
+        uintptr_t plantArray = Read<uintptr_t>(board + Off::PLANT_ARRAY);
+        int plantMax = Read<int>(board + Off::PLANT_COUNT_MAX);
+        if ((mask & STATE_PLANTS) &&
+            plantArray && plantMax > 0 && plantMax <= 200) {
+            for (int i = 0; i < plantMax; i++) {
+                uintptr_t addr = plantArray + i * Off::PLANT_SIZE;
+                if (Read<bool>(addr + Off::P_DEAD)) continue;
+
+                PlantRecord rec = {};
+                rec.index = i;
+                rec.row = Read<int>(addr + Off::P_ROW);
+                rec.col = Read<int>(addr + Off::P_COL);
+                rec.type = Read<int>(addr + Off::P_TYPE);
+                rec.hp = Read<int>(addr + Off::P_HP);
+                rec.hp_max = Read<int>(addr + Off::P_HP_MAX);
+                rec.state = Read<int>(addr + Off::P_STATE);
+                rec.shoot_countdown = Read<int>(addr + Off::P_SHOOT_COUNTDOWN);
+                rec.effective = Read<int>(addr + Off::P_EFFECTIVE);
+                rec.pumpkin_hp = Read<int>(addr + Off::P_PUMPKIN_HP);
+                rec.cob_countdown = Read<int>(addr + Off::P_COB_COUNTDOWN);
+                rec.cob_ready = Read<bool>(addr + Off::P_COB_READY) ? 1 : 0;
+                Append(body, rec);
+                header.plant_count++;
+            }
+        }
+
+        // 卡槽记录
+        uintptr_t seedArray = Read<uintptr_t>(board + Off::SEED_ARRAY);
+        if ((mask & STATE_SEEDS) && seedArray) {
+            for (int i = 0; i < 10; i++) {
+                uintptr_t addr = seedArray + i * Off::SEED_SIZE;
+                SeedRecord rec = {};
+                rec.index = i;
+                rec.type = Read<int>(addr + Off::S_TYPE);
+                rec.recharge_countdown = Read<int>(addr + Off::S_RECHARGE_COUNTDOWN);
+                rec.recharge_time = Read<int>(addr + Off::S_RECHARGE_TIME);
+                rec.usable = Read<bool>(addr + Off::S_USABLE) ? 1 : 0;
+                rec.imitator_type = Read<int>(addr + Off::S_IMITATOR_TYPE);
+                Append(body, rec);
+                header.seed_count++;
+            }
+        }
+    }
+
+    FrameHeader frame = {};
+    frame.magic = FRAME_MAGIC;
+    frame.length = (uint32_t)(sizeof(StateHeader) + body.size());
+    frame.type = frameType;
+
+    out.reserve(sizeof(FrameHeader) + frame.length);
+    Append(out, frame);
+    Append(out, header);
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+void BuildErrorFrame(std::vector<char>& out, const std::string& message) {
+    FrameHeader frame = {};
+    frame.magic = FRAME_MAGIC;
+    frame.length = (uint32_t)message.size();
+    frame.type = FRAME_TYPE_ERR;
+
+    out.reserve(sizeof(FrameHeader) + frame.length);
+    Append(out, frame);
+    out.insert(out.end(), message.begin(), message.end());
+}
+
 }  // namespace State
@@ -1,15 +1,39 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 // 游戏状态序列化
-// 收集完整的游戏状态并序列化为JSON格式
+// v1: JSON格式；v2: 二进制帧（布局见hook_client/protocol.py）
 
 namespace State {
 
+// v2帧类型（与hook_client/protocol.py的FrameType一致）
+constexpr unsigned char FRAME_TYPE_STATE = 1;  // 请求/响应状态帧
+constexpr unsigned char FRAME_TYPE_ERR = 3;    // 错误响应帧（延迟回复路径）
+constexpr unsigned char FRAME_TYPE_PUSH = 4;   // 订阅推送状态帧
+
+// STATE字段掩码（与hook_client/protocol.py的STATE_*一致）
+// 标量头任何掩码下都包含；高位掩码无线上表示，帧里忽略
+constexpr unsigned int STATE_ZOMBIES = 0x1;
+constexpr unsigned int STATE_PLANTS = 0x2;
+constexpr unsigned int STATE_SEEDS = 0x4;
+constexpr unsigned int STATE_ALL = 0x7F;
+
 // 获取完整游戏状态（JSON格式）
 std::string GetGameState();
 
+// 获取游戏状态（v2二进制帧，含帧头）
+// frameType区分响应帧和订阅推送帧，客户端据此路由；
+// mask按STATE_*位选取实体段，辅助循环只取标量+卡槽时帧缩到几十字节
+void GetGameStateBinary(std::vector<char>& out,
+                        unsigned char frameType = FRAME_TYPE_STATE,
+                        unsigned int mask = STATE_ALL);
+
+// 构造错误帧（v2二进制，载荷为错误消息）
+// 延迟回复路径上客户端在等二进制帧，文本ERR会被当作帧头解析
+void BuildErrorFrame(std::vector<char>& out, const std::string& message);
+
 // 游戏状态结构（内部使用）
 struct GameStateInfo {
     int sun;
@@ -4,7 +4,10 @@ Python客户端，用于与Hook DLL通信
 """
 
 from .client import HookClient
-from .injector import inject_dll, find_pvz_process
+from .async_client import AsyncHookClient
+from .injector import inject_dll, inject_all, find_pvz_process, find_all_pvz_processes
 from .protocol import Command, Response
 
-__all__ = ['HookClient', 'inject_dll', 'find_pvz_process', 'Command', 'Response']
+__all__ = ['HookClient', 'AsyncHookClient', 'inject_dll', 'inject_all',
+           'find_pvz_process', 'find_all_pvz_processes',
+           'Command', 'Response']
@@ -0,0 +1,549 @@
+"""
+Async Hook Client
+基于asyncio的Hook DLL客户端
+
+单连接上支持多个在途请求：每条文本命令带"#<id>"请求标签，
+Hook侧在响应中回带标签，按id匹配future；二进制状态帧不带
+标签，按发送顺序匹配。一个事件循环即可驱动全部游戏实例，
+无需每实例一个线程。
+"""
+
+import asyncio
+import json
+import logging
+from collections import deque
+from typing import AsyncIterator, Dict, List, Optional
+
+from .protocol import (
+    Command, Response, FrameType,
+    PROTOCOL_V1, PROTOCOL_V2,
+    FRAME_MAGIC, FRAME_HEADER, decode_state_frame,
+    STATE_ALL,
+)
+
+logger = logging.getLogger(__name__)
+
+# v2帧magic的首字节（'P'），用于区分二进制帧和文本行
+_FRAME_FIRST_BYTE = FRAME_MAGIC & 0xFF
+
+
+class AsyncHookClient:
+    """
+    异步Hook DLL客户端
+
+    所有命令方法均为协程；多个await可同时在途，
+    响应由后台读取任务按请求标签分发。
+    """
+
+    def __init__(self, host: str = '127.0.0.1', port: int = 12345,
+                 timeout: float = 5.0):
+        """
+        初始化客户端
+
+        Args:
+            host: 服务器地址
+            port: 服务器端口
+            timeout: 单个请求超时时间（秒）
+        """
+        self.host = host
+        self.port = port
+        self.timeout = timeout
+        self.connected = False
+        self.protocol_version = PROTOCOL_V1
+        self.server_pid: Optional[int] = None
+        self._reader: Optional[asyncio.StreamReader] = None
+        self._writer: Optional[asyncio.StreamWriter] = None
+        self._reader_task: Optional[asyncio.Task] = None
+        self._next_id = 0
+        self._pending: Dict[int, asyncio.Future] = {}
+        self._frame_waiters: 'asyncio.Queue[asyncio.Future]' = None
+        self._buf = bytearray()
+        # 订阅推送：有界队列，满时丢最旧帧（慢消费者只看到最新状态）
+        self._push_frames: 'deque[bytes]' = deque(maxlen=16)
+        self._push_event = asyncio.Event()
+        self.subscribed = False
+
+    async def connect(self) -> bool:
+        """
+        连接并协商协议版本
+
+        Returns:
+            True if successful
+        """
+        if self.connected:
+            return True
+
+        try:
+            self._reader, self._writer = await asyncio.wait_for(
+                asyncio.open_connection(self.host, self.port), self.timeout)
+        except (OSError, asyncio.TimeoutError) as e:
+            logger.error(f"Connection failed: {e}")
+            return False
+
+        self.connected = True
+        self._frame_waiters = asyncio.Queue()
+        self._reader_task = asyncio.ensure_future(self._read_loop())
+        await self._negotiate()
+        return True
+
+    async def close(self):
+        """断开连接，取消所有在途请求"""
+        self.connected = False
+        if self._reader_task is not None:
+            self._reader_task.cancel()
+            self._reader_task = None
+        if self._writer is not None:
+            self._writer.close()
+            self._writer = None
+        self._reader = None
+        self._fail_pending(ConnectionError("Client closed"))
+        self.protocol_version = PROTOCOL_V1
+
+    def _fail_pending(self, exc: Exception):
+        """让所有等待中的future以异常结束"""
+        for future in self._pending.values():
+            if not future.done():
+                future.set_exception(exc)
+        self._pending.clear()
+        if self._frame_waiters is not None:
+            while not self._frame_waiters.empty():
+                future = self._frame_waiters.get_nowait()
+                if not future.done():
+                    future.set_exception(exc)
+
+    async def _negotiate(self):
+        """协商协议版本，失败时保持v1"""
+        response = await self._request(f"{Command.HELLO} {PROTOCOL_V2}")
+        if response and Response.is_success(response):
+            parts = response.split()
+            try:
+                self.protocol_version = int(parts[1])
+            except (IndexError, ValueError):
+                self.protocol_version = PROTOCOL_V1
+            try:
+                self.server_pid = int(parts[2])
+            except (IndexError, ValueError):
+                self.server_pid = None
+
+    # ========================================================================
+    # 收发底层
+    # ========================================================================
+
+    async def _read_loop(self):
+        """后台读取任务：区分二进制帧和文本行，分发到对应future"""
+        try:
+            while True:
+                message = await self._read_message()
+                if message is None:
+                    break
+                kind, payload = message
+                if kind == 'frame':
+                    self._dispatch_frame(*payload)
+                else:
+                    self._dispatch_line(payload)
+        except asyncio.CancelledError:
+            return
+        except Exception as e:
+            logger.error(f"Reader task error: {e}")
+        self.connected = False
+        self._fail_pending(ConnectionError("Connection lost"))
+
+    async def _read_message(self):
+        """
+        读取一条完整消息
+
+        Returns:
+            ('frame', (frame_type, payload)) 或 ('line', text)，
+            连接关闭返回None
+        """
+        while True:
+            if self._buf:
+                if self._buf[0] == _FRAME_FIRST_BYTE:
+                    # 二进制帧：帧头自带长度
+                    if len(self._buf) >= FRAME_HEADER.size:
+                        magic, length, frame_type = FRAME_HEADER.unpack_from(
+                            self._buf, 0)
+                        if magic != FRAME_MAGIC:
+                            logger.error(f"Bad frame magic: {magic:#x}")
+                            return None
+                        total = FRAME_HEADER.size + length
+                        if len(self._buf) >= total:
+                            payload = bytes(self._buf[FRAME_HEADER.size:total])
+                            del self._buf[:total]
+                            return 'frame', (frame_type, payload)
+                else:
+                    # 文本行：换行结尾
+                    newline = self._buf.find(b'\n')
+                    if newline != -1:
+                        line = self._buf[:newline].decode('utf-8').strip()
+                        del self._buf[:newline + 1]
+                        return 'line', line
+            data = await self._reader.read(4096)
+            if not data:
+                return None
+            self._buf += data
+
+    def _dispatch_line(self, line: str):
+        """按请求标签把文本响应交给对应future"""
+        if not line:
+            return
+        if line[0] != '#':
+            logger.warning(f"Untagged response dropped: {line!r}")
+            return
+        tag, _, rest = line.partition(' ')
+        try:
+            request_id = int(tag[1:])
+        except ValueError:
+            logger.warning(f"Bad response tag: {line!r}")
+            return
+        future = self._pending.pop(request_id, None)
+        if future is not None and not future.done():
+            future.set_result(rest)
+
+    def _dispatch_frame(self, frame_type: int, payload: bytes):
+        """把二进制帧交给最早的等待者（服务端按序响应）"""
+        # 订阅推送帧不占用响应等待者，进有界队列（满时自动丢最旧）
+        if frame_type == FrameType.PUSH:
+            self._push_frames.append(payload)
+            self._push_event.set()
+            return
+        if self._frame_waiters.empty():
+            logger.warning(f"Unexpected frame (type {frame_type}) dropped")
+            return
+        future = self._frame_waiters.get_nowait()
+        if not future.done():
+            future.set_result((frame_type, payload))
+
+    async def _request(self, command: str) -> Optional[str]:
+        """
+        发送带标签的文本命令并等待其响应
+
+        Args:
+            command: 命令字符串
+
+        Returns:
+            响应字符串（不含标签），失败返回None
+        """
+        if not self.connected:
+            if not await self.connect():
+                return None
+
+        self._next_id += 1
+        request_id = self._next_id
+        future = asyncio.get_event_loop().create_future()
+        self._pending[request_id] = future
+
+        try:
+            self._writer.write(f"#{request_id} {command}\n".encode('utf-8'))
+            await self._writer.drain()
+            return await asyncio.wait_for(future, self.timeout)
+        except (asyncio.TimeoutError, ConnectionError, OSError) as e:
+            logger.error(f"Request failed ({command.split()[0]}): {e}")
+            self._pending.pop(request_id, None)
+            return None
+
+    async def _request_frame(self, command: str,
+                             timeout: Optional[float] = None) -> Optional[tuple]:
+        """
+        发送命令并等待一个二进制帧响应
+
+        Args:
+            command: 命令字符串（不带标签，帧按序匹配）
+            timeout: 等待超时（秒），默认用self.timeout
+
+        Returns:
+            (frame_type, payload)元组，失败返回None
+        """
+        if not self.connected:
+            if not await self.connect():
+                return None
+
+        future = asyncio.get_event_loop().create_future()
+        await self._frame_waiters.put(future)
+
+        try:
+            self._writer.write((command + '\n').encode('utf-8'))
+            await self._writer.drain()
+            return await asyncio.wait_for(
+                future, timeout if timeout is not None else self.timeout)
+        except (asyncio.TimeoutError, ConnectionError, OSError) as e:
+            logger.error(f"Frame request failed ({command.split()[0]}): {e}")
+            return None
+
+    async def _simple(self, command: str) -> bool:
+        """发送命令，返回是否成功"""
+        response = await self._request(command)
+        return bool(response) and Response.is_success(response)
+
+    # ========================================================================
+    # 命令接口（与HookClient一一对应）
+    # ========================================================================
+
+    async def plant(self, row: int, col: int, plant_type: int) -> bool:
+        """种植物"""
+        return await self._simple(f"{Command.PLANT} {row} {col} {plant_type}")
+
+    async def shovel(self, row: int, col: int) -> bool:
+        """铲植物"""
+        return await self._simple(f"{Command.SHOVEL} {row} {col}")
+
+    async def fire_cob(self, x: int, y: int) -> bool:
+        """发射玉米炮"""
+        return await self._simple(f"{Command.FIRE} {x} {y}")
+
+    async def reset(self) -> bool:
+        """重置关卡"""
+        return await self._simple(Command.RESET)
+
+    async def set_seed(self, seed: Optional[int]) -> bool:
+        """固定游戏随机种子（None恢复随机），重置后关卡可复现"""
+        arg = 'off' if seed is None else str(int(seed))
+        return await self._simple(f"{Command.SEED} {arg}")
+
+    async def set_render(self, mode) -> bool:
+        """渲染门控：True/'on'、False/'off'或整数n（每n个tick绘制一帧）"""
+        if mode is True or mode == 'on':
+            arg = 'on'
+        elif mode is False or mode == 'off':
+            arg = 'off'
+        else:
+            arg = str(int(mode))
+        return await self._simple(f"{Command.RENDER} {arg}")
+
+    async def enter_game(self, mode: int) -> bool:
+        """进入游戏模式"""
+        return await self._simple(f"{Command.ENTER} {mode}")
+
+    async def choose_card(self, plant_type: int) -> bool:
+        """选卡"""
+        return await self._simple(f"{Command.CHOOSE} {plant_type}")
+
+    async def rock(self) -> bool:
+        """点击开始游戏按钮"""
+        return await self._simple(Command.ROCK)
+
+    async def back_to_main(self) -> bool:
+        """返回主菜单"""
+        return await self._simple(Command.BACK)
+
+    async def collect(self) -> int:
+        """收集全部掉落物，返回收集数"""
+        response = await self._request(Command.COLLECT)
+        if not response or not Response.is_success(response):
+            return 0
+        parts = response.split()
+        try:
+            return int(parts[1])
+        except (IndexError, ValueError):
+            return 0
+
+    async def set_auto_collect(self, enabled: bool) -> bool:
+        """开关DLL侧每tick自动收集"""
+        return await self._simple(
+            f"{Command.AUTOCOLLECT} {'on' if enabled else 'off'}")
+
+    async def pause(self) -> bool:
+        """暂停游戏逻辑"""
+        return await self._simple(Command.PAUSE)
+
+    async def resume(self) -> bool:
+        """恢复游戏逻辑"""
+        return await self._simple(Command.RESUME)
+
+    async def execute_batch(self, commands: List[str]) -> List[bool]:
+        """批量执行命令（单帧内原子）"""
+        if not commands:
+            return []
+        response = await self._request(f"{Command.BATCH} " + ";".join(commands))
+        if not response or not Response.is_success(response):
+            return [False] * len(commands)
+        parts = response.split(None, 1)
+        flags = parts[1].split(',') if len(parts) > 1 else []
+        results = [flag == '1' for flag in flags]
+        while len(results) < len(commands):
+            results.append(False)
+        return results[:len(commands)]
+
+    async def get_state(self, fields: int = STATE_ALL) -> Optional[Dict]:
+        """
+        获取游戏状态
+
+        v2协议走二进制帧，v1回退到JSON（掩码仅v2生效）。
+
+        Args:
+            fields: STATE_*字段掩码，只序列化选中的实体段
+
+        Returns:
+            游戏状态字典，失败返回None
+        """
+        if self.protocol_version >= PROTOCOL_V2:
+            cmd = Command.STATE_BINARY
+            if fields != STATE_ALL:
+                cmd = f"{cmd} {fields}"
+            frame = await self._request_frame(cmd)
+            if frame is None:
+                return None
+            frame_type, payload = frame
+            if frame_type == FrameType.ERR:
+                logger.error(
+                    f"State read failed: {payload.decode('utf-8', 'replace')}")
+                return None
+            if frame_type != FrameType.STATE:
+                logger.error(f"Unexpected frame type: {frame_type}")
+                return None
+            return decode_state_frame(payload)
+
+        response = await self._request(Command.STATE)
+        if not response:
+            return None
+        try:
+            return json.loads(response)
+        except json.JSONDecodeError as e:
+            logger.error(f"Failed to parse state: {e}")
+            return None
+
+    async def step(self, n_ticks: int = 1) -> Optional[Dict]:
+        """
+        锁步推进游戏并返回步进后的状态
+
+        Args:
+            n_ticks: 推进的tick数
+
+        Returns:
+            游戏状态字典，失败返回None
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            logger.error("STEP requires protocol v2 (old hook DLL?)")
+            return None
+        frame = await self._request_frame(f"{Command.STEP} {n_ticks}")
+        if frame is None:
+            return None
+        frame_type, payload = frame
+        if frame_type != FrameType.STATE:
+            logger.error(f"Unexpected frame type: {frame_type}")
+            return None
+        return decode_state_frame(payload)
+
+    async def save_state(self, slot: int = 0) -> bool:
+        """保存Board快照到Hook进程内缓冲区"""
+        return await self._simple(f"{Command.SAVE_STATE} {slot}")
+
+    async def load_state(self, slot: int = 0) -> bool:
+        """恢复Board快照（仅同一Board实例内有效）"""
+        return await self._simple(f"{Command.LOAD_STATE} {slot}")
+
+    async def drop_state(self, slot: int = 0) -> bool:
+        """删除Board快照释放内存"""
+        return await self._simple(f"{Command.DROP_STATE} {slot}")
+
+    async def reset_and_start(self, mode: int, cards: List[int],
+                              timeout: float = 15.0) -> Optional[Dict]:
+        """
+        快速重置：进入模式+选卡+开始一次往返完成
+
+        Hook侧状态机在游戏线程上连续执行，事务期间连跑tick
+        快进选卡动画，返回板子可操作后的开局状态。
+
+        Args:
+            mode: 游戏模式
+            cards: 选卡的植物类型列表
+            timeout: 事务超时（秒）
+
+        Returns:
+            开局后的游戏状态字典，失败返回None
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            logger.error("RESETSTART requires protocol v2 (old hook DLL?)")
+            return None
+        card_list = ','.join(str(c) for c in cards)
+        cmd = f"{Command.RESET_AND_START} {mode} {card_list}".rstrip()
+        frame = await self._request_frame(cmd, timeout=timeout)
+        if frame is None:
+            return None
+        frame_type, payload = frame
+        if frame_type != FrameType.STATE:
+            logger.error(f"Unexpected frame type: {frame_type}")
+            return None
+        return decode_state_frame(payload)
+
+    async def subscribe(self, interval_ticks: int, queue_size: int = 16,
+                        fields: int = STATE_ALL) -> bool:
+        """
+        订阅状态推送
+
+        Hook侧每隔interval_ticks个tick主动推一帧二进制状态，
+        免去请求腿的往返延迟。推送帧进有界队列，消费不及时
+        自动丢最旧帧。需要v2协议。
+
+        Args:
+            interval_ticks: 推送间隔（tick数）
+            queue_size: 推送队列上限
+            fields: STATE_*字段掩码，推送帧只含选中的实体段
+
+        Returns:
+            True if successful
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            logger.error("SUBSCRIBE requires protocol v2 (old hook DLL?)")
+            return False
+        cmd = f"{Command.SUBSCRIBE} {interval_ticks}"
+        if fields != STATE_ALL:
+            cmd = f"{cmd} {fields}"
+        if await self._simple(cmd):
+            self._push_frames = deque(maxlen=queue_size)
+            self._push_event.clear()
+            self.subscribed = True
+            return True
+        return False
+
+    async def unsubscribe(self) -> bool:
+        """取消状态推送订阅"""
+        self.subscribed = False
+        return await self._simple(Command.UNSUBSCRIBE)
+
+    async def push_stream(self) -> AsyncIterator[Dict]:
+        """
+        订阅推送流：按到达顺序产出Hook推来的状态
+
+        需先调用subscribe()。断开连接或unsubscribe()后迭代结束。
+
+        Yields:
+            游戏状态字典
+        """
+        while self.connected and self.subscribed:
+            if self._push_frames:
+                yield decode_state_frame(self._push_frames.popleft())
+                continue
+            self._push_event.clear()
+            try:
+                await asyncio.wait_for(self._push_event.wait(), self.timeout)
+            except asyncio.TimeoutError:
+                continue
+
+    async def state_stream(self, interval: float = 0.0) -> AsyncIterator[Dict]:
+        """
+        状态订阅流
+
+        轮询式实现：每次迭代拉取一帧最新状态。固定tick节奏的
+        消费用subscribe()+push_stream()，不受sleep精度影响。
+
+        Args:
+            interval: 两次拉取之间的最小间隔（秒）
+
+        Yields:
+            游戏状态字典
+        """
+        while self.connected:
+            state = await self.get_state()
+            if state is None:
+                return
+            yield state
+            if interval > 0:
+                await asyncio.sleep(interval)
+
+    async def __aenter__(self) -> 'AsyncHookClient':
+        await self.connect()
+        return self
+
+    async def __aexit__(self, exc_type, exc_val, exc_tb):
+        await self.close()
@@ -6,8 +6,19 @@ TCP客户端，连接到Hook DLL
 import socket
 import json
 import logging
-from typing import Optional, Dict
-from .protocol import Command, Response
+import queue
+import threading
+import time
+from collections import deque
+from typing import Callable, Iterator, List, Optional, Dict
+
+from utils import perf
+from .protocol import (
+    Command, Response, FrameType,
+    PROTOCOL_V1, PROTOCOL_V2,
+    FRAME_MAGIC, FRAME_HEADER, decode_state_frame,
+    STATE_ALL,
+)
 
 # Setup logger
 logger = logging.getLogger(__name__)
@@ -16,37 +27,78 @@ logger = logging.getLogger(__name__)
 class HookClient:
     """Hook DLL客户端"""
     
-    def __init__(self, host: str = '127.0.0.1', port: int = 12345, timeout: float = 5.0):
+    def __init__(self, host: str = '127.0.0.1', port: int = 12345,
+                 timeout: float = 5.0,
+                 command_timeout: Optional[float] = None,
+                 auto_reconnect: bool = False,
+                 offline_queue: int = 0,
+                 max_backoff: float = 30.0):
         """
         初始化客户端
-        
+
         Args:
             host: 服务器地址
             port: 服务器端口
             timeout: 连接超时时间（秒）
+            command_timeout: 单个命令的截止时间（秒），默认同timeout。
+                             连接超时和命令超时分开配，训练循环可以
+                             用短命令超时快速发现卡顿的实例
+            auto_reconnect: 断线后由后台线程指数退避重连；期间命令
+                            快速失败（或进离线队列），不再让调用方
+                            付一次阻塞connect的代价
+            offline_queue: 断线期间缓存的命令数上限（0=快速失败）。
+                           缓存的命令在重连后按序补发，响应丢弃，
+                           只适合幂等的设置类命令
+            max_backoff: 重连退避上限（秒）
         """
         self.host = host
         self.port = port
         self.timeout = timeout
+        self.command_timeout = command_timeout if command_timeout is not None else timeout
+        self.auto_reconnect = auto_reconnect
+        self.max_backoff = max_backoff
         self.socket: Optional[socket.socket] = None
         self.connected = False
+        self.protocol_version = PROTOCOL_V1
+        self.server_pid: Optional[int] = None
+        self.shm_reader = None  # SharedMemoryStateReader（同主机时自动启用）
         self.logger = logging.getLogger(__name__)
-    
+        # 订阅推送：监听线程 + 有界队列（满时丢最旧帧）
+        self._sub_active = False
+        self._sub_thread: Optional[threading.Thread] = None
+        self._sub_lines: Optional[queue.Queue] = None
+        self._push_queue: Optional[deque] = None
+        self._push_ready = threading.Event()
+        self._push_callback: Optional[Callable[[Dict], None]] = None
+        # 断线重连状态（health()对外暴露）
+        self._closing = False
+        self._reconnecting = False
+        self._reconnect_lock = threading.Lock()
+        self._failures = 0
+        self._reconnects = 0
+        self._last_error: Optional[str] = None
+        self._offline: deque = deque(maxlen=max(0, offline_queue))
+
     def connect(self) -> bool:
         """
         连接到Hook DLL
-        
+
+        连接成功后自动协商协议版本（旧版DLL保持v1文本协议）。
+
         Returns:
             True if successful
         """
         if self.connected:
             return True
-        
+
         try:
             self.socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
             self.socket.settimeout(self.timeout)
             self.socket.connect((self.host, self.port))
+            # 连上后切到命令截止时间（与连接超时分开配置）
+            self.socket.settimeout(self.command_timeout)
             self.connected = True
+            self._negotiate()
             return True
         except socket.timeout as e:
             self.logger.error(f"Connection timeout: {e}")
@@ -66,6 +118,10 @@ class HookClient:
     
     def disconnect(self):
         """断开连接"""
+        self._sub_active = False
+        if self._sub_thread is not None:
+            self._sub_thread.join(timeout=2.0)
+            self._sub_thread = None
         if self.socket:
             try:
                 self.socket.close()
@@ -73,6 +129,66 @@ class HookClient:
                 pass
             self.socket = None
         self.connected = False
+        self.protocol_version = PROTOCOL_V1
+        if self.shm_reader is not None:
+            self.shm_reader.close()
+            self.shm_reader = None
+
+    def _negotiate(self):
+        """协商协议版本，失败时保持v1"""
+        response = self._send_command(f"{Command.HELLO} {PROTOCOL_V2}")
+        if response and Response.is_success(response):
+            parts = response.split()
+            try:
+                self.protocol_version = int(parts[1])
+            except (IndexError, ValueError):
+                self.protocol_version = PROTOCOL_V1
+            try:
+                self.server_pid = int(parts[2])
+            except (IndexError, ValueError):
+                self.server_pid = None
+        # 同主机部署时优先挂载共享内存状态通道
+        if self.server_pid and self.shm_reader is None and self._is_local():
+            from .shared_memory import SharedMemoryStateReader
+            reader = SharedMemoryStateReader(self.server_pid)
+            if reader.open():
+                self.shm_reader = reader
+                self.logger.info(f"Using shared memory state channel ({reader.name})")
+
+    def _is_local(self) -> bool:
+        """检查目标是否是本机"""
+        return self.host in ('127.0.0.1', 'localhost', '::1')
+
+    def _recv_exact(self, size: int) -> Optional[bytes]:
+        """接收指定字节数，连接断开返回None"""
+        chunks = []
+        remaining = size
+        while remaining > 0:
+            chunk = self.socket.recv(remaining)
+            if not chunk:
+                return None
+            chunks.append(chunk)
+            remaining -= len(chunk)
+        return b''.join(chunks)
+
+    def _recv_frame(self) -> Optional[tuple]:
+        """
+        接收一个v2二进制帧
+
+        Returns:
+            (frame_type, payload)元组，失败返回None
+        """
+        header = self._recv_exact(FRAME_HEADER.size)
+        if header is None:
+            return None
+        magic, length, frame_type = FRAME_HEADER.unpack(header)
+        if magic != FRAME_MAGIC:
+            self.logger.error(f"Bad frame magic: {magic:#x}")
+            return None
+        payload = self._recv_exact(length) if length > 0 else b''
+        if payload is None:
+            return None
+        return frame_type, payload
     
     def _send_command(self, command: str) -> Optional[str]:
         """
@@ -84,38 +200,129 @@ class HookClient:
         Returns:
             响应字符串，失败返回None
         """
+        # 订阅期间监听线程拥有socket读端，先unsubscribe再发其他命令
+        if self._sub_active:
+            self.logger.error("Cannot send commands while subscribed")
+            return None
+
         if not self.connected:
+            # 自动重连模式下不在调用路径上付阻塞connect的代价：
+            # 触发后台重连，命令快速失败或进离线队列
+            if self.auto_reconnect and not self._closing:
+                self._start_reconnect()
+                if self._offline.maxlen:
+                    self._offline.append(command)
+                return None
             if not self.connect():
                 return None
-        
+
+        # 分阶段计时（utils.perf开启时）：socket写入/首字节/总耗时，
+        # 便于区分游戏线程卡顿、桥接排队还是解析慢
+        tracing = perf.enabled()
         try:
-            # 发送命令
+            start = time.perf_counter() if tracing else 0.0
             self.socket.sendall((command + '\n').encode('utf-8'))
-            
+            if tracing:
+                sent = time.perf_counter()
+                perf.record('hook.write', sent - start)
+
             # 接收响应
             response = b''
+            first_byte = None
             while True:
                 chunk = self.socket.recv(4096)
+                if tracing and first_byte is None:
+                    first_byte = time.perf_counter()
+                    perf.record('hook.first_byte', first_byte - sent)
                 if not chunk:
                     break
                 response += chunk
                 if b'\n' in response:
                     break
-            
+
+            if tracing:
+                perf.record('hook.total', time.perf_counter() - start)
+            if not response:
+                # 对端关闭连接（recv返回空）
+                self._connection_lost(ConnectionError("connection closed"))
+                return None
             return response.decode('utf-8').strip()
         except socket.timeout as e:
             self.logger.error(f"Command timeout: {e}")
-            self.disconnect()
+            self._connection_lost(e)
             return None
         except socket.error as e:
             self.logger.error(f"Socket error: {e}")
-            self.disconnect()
+            self._connection_lost(e)
             return None
         except Exception as e:
             self.logger.error(f"Unexpected error: {e}")
-            self.disconnect()
+            self._connection_lost(e)
             return None
-    
+
+    def _connection_lost(self, error: Exception):
+        """连接失效：记录错误并（配置了的话）启动后台重连"""
+        self._last_error = str(error) or type(error).__name__
+        self._failures += 1
+        self.disconnect()
+        if self.auto_reconnect and not self._closing:
+            self._start_reconnect()
+
+    def _start_reconnect(self):
+        """启动后台重连线程（幂等）"""
+        with self._reconnect_lock:
+            if self._reconnecting or self._closing:
+                return
+            self._reconnecting = True
+        threading.Thread(target=self._reconnect_loop, daemon=True,
+                         name='hook-reconnect').start()
+
+    def _reconnect_loop(self):
+        """指数退避重连，成功后补发离线队列里的命令"""
+        backoff = 0.25
+        try:
+            while not self._closing:
+                if self.connect():
+                    self._failures = 0
+                    self._reconnects += 1
+                    self._flush_offline()
+                    return
+                self._last_error = f"reconnect failed ({self.host}:{self.port})"
+                time.sleep(backoff)
+                backoff = min(backoff * 2, self.max_backoff)
+        finally:
+            self._reconnecting = False
+
+    def _flush_offline(self):
+        """按序补发离线期间缓存的命令（响应丢弃）"""
+        while self._offline and self.connected:
+            command = self._offline.popleft()
+            self._send_command(command)
+
+    def health(self) -> Dict:
+        """
+        连接健康状况
+
+        向量环境层据此屏蔽死实例，而不是让整个同步batch
+        卡在一个挂掉的连接上。
+
+        Returns:
+            dict: connected/reconnecting/failures/reconnects/queued/last_error
+        """
+        return {
+            'connected': self.connected,
+            'reconnecting': self._reconnecting,
+            'failures': self._failures,
+            'reconnects': self._reconnects,
+            'queued': len(self._offline),
+            'last_error': self._last_error,
+        }
+
+    def close(self):
+        """永久关闭：停止重连线程并断开"""
+        self._closing = True
+        self.disconnect()
+
     def plant(self, row: int, col: int, plant_type: int) -> bool:
         """
         种植物
@@ -172,6 +379,49 @@ class HookClient:
         response = self._send_command(Command.RESET)
         return response and Response.is_success(response)
     
+    def set_seed(self, seed: Optional[int]) -> bool:
+        """
+        固定游戏随机种子
+
+        固定后每次重置（reset/reset_and_start）前Hook都把种子写回，
+        同一种子开出的关卡出怪列表和僵尸行为完全一致：复现一次失败
+        只需重放一个episode，A/B评测也不用靠海量episode摊平随机性。
+
+        Args:
+            seed: 种子值，None恢复随机
+
+        Returns:
+            True if successful
+        """
+        arg = 'off' if seed is None else str(int(seed))
+        response = self._send_command(f"{Command.SEED} {arg}")
+        return response and Response.is_success(response)
+
+    def set_render(self, mode) -> bool:
+        """
+        渲染门控
+
+        关闭后Hook跳过Board::Draw，模拟照常推进：TickMs压到1ms时
+        绘制占掉大半帧预算，跳过绘制单实例吞吐从~300提到1000+
+        tick/s。every_n模式按模拟tick计数，每n个tick绘制一帧
+        （STEP锁步burst的中间tick不会触发绘制）。
+
+        Args:
+            mode: True/'on'恢复绘制，False/'off'完全关闭，
+                  整数n表示每n个tick绘制一帧
+
+        Returns:
+            True if successful
+        """
+        if mode is True or mode == 'on':
+            arg = 'on'
+        elif mode is False or mode == 'off':
+            arg = 'off'
+        else:
+            arg = str(int(mode))
+        response = self._send_command(f"{Command.RENDER} {arg}")
+        return response and Response.is_success(response)
+
     def enter_game(self, mode: int) -> bool:
         """
         进入游戏模式
@@ -220,29 +470,514 @@ class HookClient:
         response = self._send_command(Command.BACK)
         return response and Response.is_success(response)
     
-    def get_state(self) -> Optional[Dict]:
+    def collect(self) -> int:
+        """
+        收集全部掉落物（阳光、金币）
+
+        Hook侧在游戏线程单次遍历完成，替代逐item的跨进程读写。
+
+        Returns:
+            本次收集的掉落物数量，失败返回0
+        """
+        response = self._send_command(Command.COLLECT)
+        if not response or not Response.is_success(response):
+            return 0
+        parts = response.split()
+        try:
+            return int(parts[1])
+        except (IndexError, ValueError):
+            return 0
+
+    def set_auto_collect(self, enabled: bool) -> bool:
+        """
+        开关DLL侧每tick自动收集
+
+        打开后掉落物收集完全在游戏进程内进行，客户端零流量。
+
+        Args:
+            enabled: 是否自动收集
+
+        Returns:
+            True if successful
+        """
+        cmd = f"{Command.AUTOCOLLECT} {'on' if enabled else 'off'}"
+        response = self._send_command(cmd)
+        return response and Response.is_success(response)
+
+    def pause(self) -> bool:
+        """
+        暂停游戏逻辑
+
+        Hook仍每帧运行并接收命令，游戏时间停止推进。
+
+        Returns:
+            True if successful
+        """
+        response = self._send_command(Command.PAUSE)
+        return response and Response.is_success(response)
+
+    def resume(self) -> bool:
+        """
+        恢复游戏逻辑
+
+        Returns:
+            True if successful
+        """
+        response = self._send_command(Command.RESUME)
+        return response and Response.is_success(response)
+
+    def step(self, n_ticks: int = 1) -> Optional[Dict]:
+        """
+        锁步推进游戏
+
+        游戏保持暂停，精确执行n_ticks个tick后在同一响应中
+        返回步进后的状态。tick在Hook侧背靠背执行，不受游戏
+        帧率限制，训练循环无需sleep轮询。需要v2协议。
+
+        Args:
+            n_ticks: 推进的tick数
+
+        Returns:
+            步进后的游戏状态字典，失败返回None
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            self.logger.error("STEP requires protocol v2 (old hook DLL?)")
+            return None
+        if not self.connected:
+            if not self.connect():
+                return None
+
+        try:
+            self.socket.sendall(f"{Command.STEP} {n_ticks}\n".encode('utf-8'))
+            frame = self._recv_frame()
+            if frame is None:
+                self._connection_lost(ConnectionError("connection closed"))
+                return None
+            frame_type, payload = frame
+            if frame_type == FrameType.ERR:
+                # Hook侧的干净失败（连接仍健康），不触发重连
+                self.logger.error(
+                    f"Step failed: {payload.decode('utf-8', 'replace')}")
+                return None
+            if frame_type != FrameType.STATE:
+                self.logger.error(f"Unexpected frame type: {frame_type}")
+                return None
+            return decode_state_frame(payload)
+        except socket.timeout as e:
+            self.logger.error(f"Step timeout: {e}")
+            self._connection_lost(e)
+            return None
+        except socket.error as e:
+            self.logger.error(f"Socket error: {e}")
+            self._connection_lost(e)
+            return None
+
+    def subscribe(self, interval_ticks: int, queue_size: int = 16,
+                  callback: Optional[Callable[[Dict], None]] = None,
+                  fields: int = STATE_ALL) -> bool:
+        """
+        订阅状态推送
+
+        Hook侧每隔interval_ticks个tick主动推一帧状态，免去请求
+        腿的往返延迟，且推送节奏由游戏tick保证，不受sleep精度
+        影响。监听线程解码推送帧进有界队列（满时丢最旧），或
+        直接调用callback。订阅期间监听线程拥有socket读端，
+        发送其他命令前先unsubscribe()。需要v2协议。
+
+        Args:
+            interval_ticks: 推送间隔（tick数）
+            queue_size: 推送队列上限
+            callback: 可选，每帧到达时在监听线程中调用
+            fields: STATE_*字段掩码，推送帧只含选中的实体段
+
+        Returns:
+            True if successful
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            self.logger.error("SUBSCRIBE requires protocol v2 (old hook DLL?)")
+            return False
+        if self._sub_active:
+            return False
+        cmd = f"{Command.SUBSCRIBE} {interval_ticks}"
+        if fields != STATE_ALL:
+            cmd = f"{cmd} {fields}"
+        response = self._send_command(cmd)
+        if not response or not Response.is_success(response):
+            return False
+
+        self._push_queue = deque(maxlen=queue_size)
+        self._push_ready.clear()
+        self._push_callback = callback
+        self._sub_lines = queue.Queue()
+        self._sub_active = True
+        self._sub_thread = threading.Thread(
+            target=self._push_loop, daemon=True, name='hook-push')
+        self._sub_thread.start()
+        return True
+
+    def unsubscribe(self) -> bool:
+        """
+        取消状态推送订阅，停止监听线程
+
+        Returns:
+            True if successful
+        """
+        if not self._sub_active:
+            return True
+        try:
+            self.socket.sendall(f"{Command.UNSUBSCRIBE}\n".encode('utf-8'))
+        except socket.error as e:
+            self.logger.error(f"Socket error: {e}")
+            self.disconnect()
+            return False
+        # UNSUBSCRIBE的文本响应由监听线程收到后转交
+        try:
+            line = self._sub_lines.get(timeout=self.timeout)
+            ok = Response.is_success(line)
+        except queue.Empty:
+            ok = False
+        self._sub_active = False
+        self._sub_thread.join(timeout=2.0)
+        self._sub_thread = None
+        return ok
+
+    def pushed_states(self) -> Iterator[Dict]:
+        """
+        订阅推送流：按到达顺序产出Hook推来的状态
+
+        需先调用subscribe()（未传callback）。取消订阅或断线后
+        迭代结束。
+
+        Yields:
+            游戏状态字典
+        """
+        while self._sub_active:
+            if self._push_queue:
+                yield self._push_queue.popleft()
+                continue
+            self._push_ready.clear()
+            self._push_ready.wait(self.timeout)
+
+    def _push_loop(self):
+        """监听线程：读推送帧进队列，文本行转交unsubscribe"""
+        try:
+            while self._sub_active:
+                # 首字节用短超时轮询，便于及时响应退出
+                self.socket.settimeout(0.5)
+                try:
+                    first = self.socket.recv(1)
+                except socket.timeout:
+                    continue
+                if not first:
+                    break
+                self.socket.settimeout(self.command_timeout)
+
+                if first[0] == FRAME_MAGIC & 0xFF:
+                    rest = self._recv_exact(FRAME_HEADER.size - 1)
+                    if rest is None:
+                        break
+                    magic, length, frame_type = FRAME_HEADER.unpack(first + rest)
+                    if magic != FRAME_MAGIC:
+                        self.logger.error(f"Bad frame magic: {magic:#x}")
+                        break
+                    payload = self._recv_exact(length) if length > 0 else b''
+                    if payload is None:
+                        break
+                    if frame_type == FrameType.PUSH:
+                        state = decode_state_frame(payload)
+                        if self._push_callback is not None:
+                            self._push_callback(state)
+                        else:
+                            self._push_queue.append(state)
+                            self._push_ready.set()
+                else:
+                    # 文本行（UNSUBSCRIBE等命令的响应）
+                    line = bytearray(first)
+                    while not line.endswith(b'\n'):
+                        chunk = self.socket.recv(1)
+                        if not chunk:
+                            break
+                        line += chunk
+                    self._sub_lines.put(line.decode('utf-8').strip())
+        except (socket.error, OSError):
+            pass
+        finally:
+            self._sub_active = False
+            self._push_ready.set()
+            try:
+                self.socket.settimeout(self.command_timeout)
+            except (socket.error, OSError, AttributeError):
+                pass
+
+    def save_state(self, slot: int = 0) -> bool:
+        """
+        保存Board快照
+
+        Hook侧把整个Board（实体数组、RNG、时钟）复制到进程内
+        缓冲区，毫秒级完成。配合load_state实现rollout树搜索和
+        从关卡中段快速重启，免去整关重放。
+
+        Args:
+            slot: 快照槽位id（重复保存覆盖）
+
+        Returns:
+            True if successful
+        """
+        response = self._send_command(f"{Command.SAVE_STATE} {slot}")
+        return response and Response.is_success(response)
+
+    def load_state(self, slot: int = 0) -> bool:
+        """
+        恢复Board快照
+
+        单tick内恢复到save_state时刻。快照仅在同一Board实例内
+        有效：重进关卡后实体数组已重新分配，旧快照会被拒绝。
+
+        Args:
+            slot: 快照槽位id
+
+        Returns:
+            True if successful
+        """
+        response = self._send_command(f"{Command.LOAD_STATE} {slot}")
+        return response and Response.is_success(response)
+
+    def drop_state(self, slot: int = 0) -> bool:
+        """
+        删除Board快照，释放Hook侧缓冲区（每份约1MB）
+
+        Args:
+            slot: 快照槽位id
+
+        Returns:
+            True if successful
+        """
+        response = self._send_command(f"{Command.DROP_STATE} {slot}")
+        return response and Response.is_success(response)
+
+    def reset_and_start(self, mode: int, cards: List[int],
+                        timeout: float = 15.0) -> Optional[Dict]:
+        """
+        快速重置：进入模式+选卡+开始一次往返完成
+
+        Hook侧状态机在游戏线程上连续执行整个流程，并在事务期间
+        连跑tick快进选卡动画，板子可操作后才返回开局状态。
+        相比reset/enter_game/choose_card/rock逐命令往返，单次
+        episode重置从秒级降到百毫秒级。需要v2协议。
+
+        Args:
+            mode: 游戏模式（如ADVENTURE_MODE）
+            cards: 选卡的植物类型列表
+            timeout: 事务超时（秒），覆盖整个重置流程
+
+        Returns:
+            开局后的游戏状态字典，失败返回None
+        """
+        if self.protocol_version < PROTOCOL_V2:
+            self.logger.error("RESETSTART requires protocol v2 (old hook DLL?)")
+            return None
+        if not self.connected:
+            if not self.connect():
+                return None
+
+        card_list = ','.join(str(c) for c in cards)
+        cmd = f"{Command.RESET_AND_START} {mode} {card_list}".rstrip()
+        try:
+            # 事务跨越多个游戏帧，临时放宽socket超时
+            self.socket.settimeout(timeout)
+            self.socket.sendall(f"{cmd}\n".encode('utf-8'))
+            frame = self._recv_frame()
+            if frame is None:
+                self._connection_lost(ConnectionError("connection closed"))
+                return None
+            frame_type, payload = frame
+            if frame_type == FrameType.ERR:
+                # Hook侧超时的干净失败（如界面卡在选卡），连接仍健康
+                self.logger.error(
+                    f"Reset failed: {payload.decode('utf-8', 'replace')}")
+                return None
+            if frame_type != FrameType.STATE:
+                self.logger.error(f"Unexpected frame type: {frame_type}")
+                return None
+            return decode_state_frame(payload)
+        except socket.timeout as e:
+            self.logger.error(f"Reset timeout: {e}")
+            self._connection_lost(e)
+            return None
+        except socket.error as e:
+            self.logger.error(f"Socket error: {e}")
+            self._connection_lost(e)
+            return None
+        finally:
+            if self.socket is not None:
+                self.socket.settimeout(self.command_timeout)
+
+    def execute_batch(self, commands: List[str]) -> List[bool]:
+        """
+        批量执行命令
+
+        所有命令在一次往返内发送，Hook侧在同一游戏帧内依次执行，
+        对游戏时间而言整批是原子的。
+
+        Args:
+            commands: 命令字符串列表（如"PLANT 2 3 0"）
+
+        Returns:
+            每条命令的执行结果列表
+        """
+        if not commands:
+            return []
+
+        cmd = f"{Command.BATCH} " + ";".join(commands)
+        response = self._send_command(cmd)
+        if not response or not Response.is_success(response):
+            return [False] * len(commands)
+
+        parts = response.split(None, 1)
+        flags = parts[1].split(',') if len(parts) > 1 else []
+        results = [flag == '1' for flag in flags]
+        # 响应数量异常时按失败补齐
+        while len(results) < len(commands):
+            results.append(False)
+        return results[:len(commands)]
+
+    def batch(self) -> 'CommandBatch':
+        """
+        创建批量命令上下文
+
+        用法:
+            with client.batch() as b:
+                b.plant(2, 8, 0)
+                b.plant(3, 8, 0)
+            print(b.results)
+
+        Returns:
+            CommandBatch实例，退出with块时发送
+        """
+        return CommandBatch(self)
+
+    def get_state(self, fields: int = STATE_ALL) -> Optional[Dict]:
         """
         获取游戏状态
-        
+
+        优先级：共享内存通道 > v2二进制帧 > v1 JSON。
+
+        Args:
+            fields: STATE_*字段掩码，只序列化选中的实体段。
+                    辅助循环（如阳光管理）传STATE_SEEDS即可把
+                    单帧从几十KB缩到几十字节。标量始终包含。
+
         Returns:
             游戏状态字典，失败返回None
         """
+        # 共享内存通道固定发布全量帧，只在取全量时走
+        if fields == STATE_ALL and self.shm_reader is not None:
+            state = self.shm_reader.read_latest()
+            if state is not None:
+                return state
+            # 通道失效（如DLL卸载）后回退到socket路径
+
+        if self.protocol_version >= PROTOCOL_V2:
+            return self._get_state_binary(fields)
+
         response = self._send_command(Command.STATE)
         if not response:
             return None
-        
+
         try:
             # 解析JSON响应
-            return json.loads(response)
+            return perf.timed_call('hook.parse_json', json.loads, response)
         except json.JSONDecodeError as e:
             self.logger.error(f"Failed to parse state: {e}, response: {response}")
             return None
+
+    def _get_state_binary(self, fields: int = STATE_ALL) -> Optional[Dict]:
+        """通过v2二进制协议获取游戏状态"""
+        if not self.connected:
+            if not self.connect():
+                return None
+
+        cmd = Command.STATE_BINARY
+        if fields != STATE_ALL:
+            cmd = f"{cmd} {fields}"
+        try:
+            self.socket.sendall((cmd + '\n').encode('utf-8'))
+            frame = self._recv_frame()
+            if frame is None:
+                self._connection_lost(ConnectionError("connection closed"))
+                return None
+            frame_type, payload = frame
+            if frame_type == FrameType.ERR:
+                self.logger.error(
+                    f"State read failed: {payload.decode('utf-8', 'replace')}")
+                return None
+            if frame_type != FrameType.STATE:
+                self.logger.error(f"Unexpected frame type: {frame_type}")
+                return None
+            return perf.timed_call('hook.decode_frame', decode_state_frame, payload)
+        except socket.timeout as e:
+            self.logger.error(f"State frame timeout: {e}")
+            self._connection_lost(e)
+            return None
+        except socket.error as e:
+            self.logger.error(f"Socket error: {e}")
+            self._connection_lost(e)
+            return None
     
+    def get_perf_stats(self) -> Dict:
+        """命令各阶段的延迟统计（需先utils.perf.enable()）"""
+        return perf.get_perf_stats('hook.')
+
     def __enter__(self):
         """Context manager support"""
         self.connect()
         return self
-    
+
     def __exit__(self, exc_type, exc_val, exc_tb):
         """Context manager support"""
-        self.disconnect()
+        self.close()
+
+
+class CommandBatch:
+    """
+    批量命令构建器
+
+    收集多条命令，退出with块时通过execute_batch()一次性发送。
+    """
+
+    def __init__(self, client: HookClient):
+        self.client = client
+        self.commands: List[str] = []
+        self.results: List[bool] = []
+
+    def plant(self, row: int, col: int, plant_type: int) -> 'CommandBatch':
+        """加入种植命令"""
+        self.commands.append(f"{Command.PLANT} {row} {col} {plant_type}")
+        return self
+
+    def shovel(self, row: int, col: int) -> 'CommandBatch':
+        """加入铲除命令"""
+        self.commands.append(f"{Command.SHOVEL} {row} {col}")
+        return self
+
+    def fire_cob(self, x: int, y: int) -> 'CommandBatch':
+        """加入玉米炮发射命令"""
+        self.commands.append(f"{Command.FIRE} {x} {y}")
+        return self
+
+    def choose_card(self, plant_type: int) -> 'CommandBatch':
+        """加入选卡命令"""
+        self.commands.append(f"{Command.CHOOSE} {plant_type}")
+        return self
+
+    def send(self) -> List[bool]:
+        """发送已收集的命令并记录结果"""
+        self.results = self.client.execute_batch(self.commands)
+        return self.results
+
+    def __enter__(self) -> 'CommandBatch':
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        if exc_type is None:
+            self.send()
@@ -8,7 +8,9 @@ import ctypes
 from ctypes import wintypes
 import psutil
 import logging
-from typing import Optional
+import time
+from concurrent.futures import ThreadPoolExecutor
+from typing import Dict, List, Optional
 
 # Setup logger
 logger = logging.getLogger(__name__)
@@ -21,22 +23,75 @@ MEM_RESERVE = 0x2000
 MEM_RELEASE = 0x8000
 PAGE_READWRITE = 0x04
 
+# PVZ进程名匹配子串
+_PVZ_NAMES = ('plantsvszombies', 'popcapgame1')
+
+# 进程发现缓存：全量process_iter扫描在进程多的主机上要几百毫秒，
+# 缓存命中时只校验已知pid是否存活，不重扫全表
+_CACHE_TTL = 5.0
+_pid_cache: List[int] = []
+_cache_time = 0.0
+
+
+def _is_pvz_pid(pid: int) -> bool:
+    """校验pid仍是存活的PVZ进程"""
+    try:
+        name = psutil.Process(pid).name().lower()
+    except (psutil.NoSuchProcess, psutil.AccessDenied):
+        return False
+    return any(s in name for s in _PVZ_NAMES)
+
+
+def _scan_pvz_pids() -> List[int]:
+    """全量扫描所有PVZ进程id"""
+    pids = []
+    for proc in psutil.process_iter(['pid', 'name']):
+        try:
+            name = proc.info['name'].lower()
+            if any(s in name for s in _PVZ_NAMES):
+                pids.append(proc.info['pid'])
+        except (psutil.NoSuchProcess, psutil.AccessDenied):
+            continue
+    return pids
+
+
+def find_all_pvz_processes(refresh: bool = False) -> List[int]:
+    """
+    查找所有PVZ进程（带缓存的增量扫描）
+
+    缓存TTL内只逐pid校验缓存结果仍存活（每个pid一次系统调用），
+    避免重复遍历全部进程；缓存过期、失效或refresh=True时重扫。
+
+    Args:
+        refresh: 跳过缓存强制全量扫描（实例刚启动时用）
+
+    Returns:
+        进程ID列表（可能为空）
+    """
+    global _pid_cache, _cache_time
+
+    now = time.monotonic()
+    if not refresh and _pid_cache and now - _cache_time < _CACHE_TTL:
+        alive = [pid for pid in _pid_cache if _is_pvz_pid(pid)]
+        if alive:
+            _pid_cache = alive
+            return list(alive)
+        # 缓存全部失效，落回全量扫描
+
+    _pid_cache = _scan_pvz_pids()
+    _cache_time = now
+    return list(_pid_cache)
+
 
 def find_pvz_process() -> Optional[int]:
     """
     查找PVZ进程
-    
+
     Returns:
         进程ID，未找到返回None
     """
-    for proc in psutil.process_iter(['pid', 'name']):
-        try:
-            name = proc.info['name'].lower()
-            if 'plantsvszombies' in name or 'popcapgame1' in name:
-                return proc.info['pid']
-        except (psutil.NoSuchProcess, psutil.AccessDenied):
-            continue
-    return None
+    pids = find_all_pvz_processes()
+    return pids[0] if pids else None
 
 
 def inject_dll(dll_path: Optional[str] = None, pid: Optional[int] = None) -> bool:
@@ -142,6 +197,47 @@ def inject_dll(dll_path: Optional[str] = None, pid: Optional[int] = None) -> boo
         kernel32.CloseHandle(hProcess)
 
 
+def inject_all(pids: Optional[List[int]] = None,
+               dll_path: Optional[str] = None,
+               max_parallel: int = 8) -> Dict[int, bool]:
+    """
+    并行注入多个PVZ进程
+
+    每个注入（VirtualAllocEx/WriteProcessMemory/CreateRemoteThread/
+    WaitForSingleObject）持有独立的进程句柄，互不相干，在线程池
+    里并发执行；32实例的集群启动耗时从串行注入之和降到最慢
+    一次注入的耗时。
+
+    Args:
+        pids: 目标进程ID列表，默认注入所有已发现的PVZ进程
+        dll_path: DLL路径，默认为hook/pvz_hook.dll
+        max_parallel: 并发注入上限
+
+    Returns:
+        {pid: 是否成功}，逐进程报告结果
+    """
+    if pids is None:
+        pids = find_all_pvz_processes(refresh=True)
+    if not pids:
+        logger.error("No PVZ processes to inject")
+        return {}
+
+    results: Dict[int, bool] = {}
+    workers = max(1, min(max_parallel, len(pids)))
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        futures = {pid: pool.submit(inject_dll, dll_path, pid) for pid in pids}
+        for pid, future in futures.items():
+            try:
+                results[pid] = bool(future.result())
+            except Exception as e:
+                logger.error(f"Injection raised for pid {pid}: {e}")
+                results[pid] = False
+
+    ok = sum(1 for v in results.values() if v)
+    logger.info(f"Injected {ok}/{len(pids)} processes")
+    return results
+
+
 if __name__ == '__main__':
     # 测试注入
     import time
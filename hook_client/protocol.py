@@ -1,7 +1,18 @@
 """
 Protocol definitions for Hook DLL communication
+
+v1: 文本协议，换行分隔的命令和JSON响应
+v2: 二进制协议，长度前缀帧 + 固定布局实体记录，
+    可通过 np.frombuffer 零拷贝解码为 numpy 数组
 """
 
+import struct
+
+
+# 协议版本
+PROTOCOL_V1 = 1  # 文本/JSON
+PROTOCOL_V2 = 2  # 二进制帧
+
 
 class Command:
     """命令常量"""
@@ -14,6 +25,141 @@ class Command:
     ROCK = "ROCK"
     BACK = "BACK"
     STATE = "STATE"
+    STATE_BINARY = "STATEB"  # v2: 二进制状态帧
+    HELLO = "HELLO"  # 协议协商
+    BATCH = "BATCH"  # 批量命令，单帧内原子执行
+    PAUSE = "PAUSE"  # 暂停游戏逻辑（Hook继续运行）
+    RESUME = "RESUME"  # 恢复游戏逻辑
+    STEP = "STEP"  # 锁步推进n个tick，响应为步进后的状态帧
+    COLLECT = "COLLECT"  # 单次收集全部掉落物，返回收集数
+    AUTOCOLLECT = "AUTOCOLLECT"  # on|off，DLL每tick自动收集
+    RESET_AND_START = "RESETSTART"  # 重置+选卡+开始一体事务，响应为开局后的状态帧
+    SAVE_STATE = "SAVESTATE"  # 保存Board快照到Hook进程内缓冲区
+    LOAD_STATE = "LOADSTATE"  # 恢复Board快照（同一Board实例内有效）
+    DROP_STATE = "DROPSTATE"  # 删除快照释放内存
+    SUBSCRIBE = "SUBSCRIBE"  # 订阅状态推送：每隔n个tick推一帧
+    UNSUBSCRIBE = "UNSUBSCRIBE"  # 取消订阅
+    SEED = "SEED"  # 固定随机种子（value|off），重置后出怪列表可复现
+    RENDER = "RENDER"  # 渲染门控（on|off|every_n），训练时跳过绘制换吞吐
+
+
+class FrameType:
+    """v2 帧类型"""
+    STATE = 1  # 完整状态帧
+    OK = 2     # 成功响应
+    ERR = 3    # 错误响应
+    PUSH = 4   # 订阅推送状态帧（非请求响应，单独路由）
+
+
+# STATE字段掩码：按需取状态，调用方只为读到的部分付带宽
+# 标量头（sun/wave/clock等）任何掩码下都包含。
+# 前三位对应v2状态帧的实体段；其余几位没有线上表示，
+# 供GameReader.read_game_state()的本地内存读取路径使用
+STATE_ZOMBIES = 0x01
+STATE_PLANTS = 0x02
+STATE_SEEDS = 0x04
+STATE_PROJECTILES = 0x08  # 仅GameReader
+STATE_LAWNMOWERS = 0x10   # 仅GameReader
+STATE_ITEMS = 0x20        # 仅GameReader
+STATE_GRID = 0x40         # 仅GameReader（场地格类型/冰道/植物网格）
+STATE_ALL = 0x7F
+
+# v2 帧头: magic(u32) + payload长度(u32) + 帧类型(u8)
+FRAME_MAGIC = 0x325A5650  # 'PVZ2' little-endian
+FRAME_HEADER = struct.Struct('<IIB')
+
+# 状态帧载荷头: 标量 + 各实体记录数
+# sun, wave, total_waves, scene, game_clock, in_game + 3个count + 对齐
+STATE_HEADER = struct.Struct('<6i3H2x')
+
+# 实体记录布局（与 hook/src/state.cpp 的 #pragma pack(1) 结构严格一致）
+# 格式为 numpy dtype 字段表；所有字段均为4字节，天然对齐
+
+ZOMBIE_FIELDS = [
+    ('index', '<i4'),
+    ('row', '<i4'),
+    ('type', '<i4'),
+    ('x', '<f4'),
+    ('y', '<f4'),
+    ('hp', '<i4'),
+    ('hp_max', '<i4'),
+    ('accessory_hp', '<i4'),
+    ('state', '<i4'),
+    ('speed', '<f4'),
+    ('slow_countdown', '<i4'),
+    ('freeze_countdown', '<i4'),
+    ('butter_countdown', '<i4'),
+    ('at_wave', '<i4'),
+]
+ZOMBIE_RECORD_SIZE = 4 * len(ZOMBIE_FIELDS)
+
+PLANT_FIELDS = [
+    ('index', '<i4'),
+    ('row', '<i4'),
+    ('col', '<i4'),
+    ('type', '<i4'),
+    ('hp', '<i4'),
+    ('hp_max', '<i4'),
+    ('state', '<i4'),
+    ('shoot_countdown', '<i4'),
+    ('effective', '<i4'),
+    ('pumpkin_hp', '<i4'),
+    ('cob_countdown', '<i4'),
+    ('cob_ready', '<i4'),
+]
+PLANT_RECORD_SIZE = 4 * len(PLANT_FIELDS)
+
+SEED_FIELDS = [
+    ('index', '<i4'),
+    ('type', '<i4'),
+    ('recharge_countdown', '<i4'),
+    ('recharge_time', '<i4'),
+    ('usable', '<i4'),
+    ('imitator_type', '<i4'),
+]
+SEED_RECORD_SIZE = 4 * len(SEED_FIELDS)
+
+
+def decode_state_frame(payload: bytes) -> dict:
+    """
+    解码 v2 状态帧载荷
+
+    实体块直接用 np.frombuffer 映射为 numpy 结构化数组（零拷贝）。
+
+    Args:
+        payload: 状态帧载荷（不含帧头）
+
+    Returns:
+        状态字典: 标量 + 'zombies'/'plants'/'seeds' numpy数组
+    """
+    import numpy as np
+
+    (sun, wave, total_waves, scene, game_clock, in_game,
+     zombie_count, plant_count, seed_count) = STATE_HEADER.unpack_from(payload, 0)
+
+    offset = STATE_HEADER.size
+    zombies = np.frombuffer(payload, dtype=np.dtype(ZOMBIE_FIELDS),
+                            count=zombie_count, offset=offset)
+    offset += zombie_count * ZOMBIE_RECORD_SIZE
+    plants = np.frombuffer(payload, dtype=np.dtype(PLANT_FIELDS),
+                           count=plant_count, offset=offset)
+    offset += plant_count * PLANT_RECORD_SIZE
+    seeds = np.frombuffer(payload, dtype=np.dtype(SEED_FIELDS),
+                          count=seed_count, offset=offset)
+
+    return {
+        'sun': sun,
+        'wave': wave,
+        'total_waves': total_waves,
+        'scene': scene,
+        'game_clock': game_clock,
+        'in_game': bool(in_game),
+        'zombie_count': zombie_count,
+        'plant_count': plant_count,
+        'zombies': zombies,
+        'plants': plants,
+        'seeds': seeds,
+    }
 
 
 class Response:
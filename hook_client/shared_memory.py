@@ -0,0 +1,144 @@
+"""
+Shared Memory State Reader
+共享内存状态通道读取端
+
+Hook DLL每帧将v2二进制状态帧发布到命名共享内存
+（Local\\pvz_hook_state_<pid>，双缓冲+序列锁），
+同主机部署时可绕过TCP轮询，读取延迟从毫秒级降到微秒级。
+"""
+
+import mmap
+import struct
+import sys
+import logging
+from typing import Optional, Dict
+
+from .protocol import FRAME_MAGIC, FRAME_HEADER, FrameType, decode_state_frame
+
+logger = logging.getLogger(__name__)
+
+# 与hook/src/shm.cpp严格一致
+SHM_MAGIC = 0x535A5650  # 'PVZS' little-endian
+SHM_VERSION = 1
+SHM_HEADER_SIZE = 64  # 头部预留空间
+SHM_BUFFER_SIZE = 64 * 1024
+
+# magic, version, buffer_size, active_index, seq[2], frame_len[2]
+SHM_HEADER = struct.Struct('<IIII2I2I')
+
+# 序列锁读取重试上限
+_MAX_RETRIES = 16
+
+
+def shm_name(pid: int) -> str:
+    """获取指定游戏进程的共享内存名称"""
+    return f"Local\\pvz_hook_state_{pid}"
+
+
+class SharedMemoryStateReader:
+    """
+    共享内存状态读取器
+
+    映射Hook DLL发布的状态缓冲区，read_latest()无系统调用、
+    无socket往返地返回最新快照。仅支持Windows同主机部署。
+    """
+
+    def __init__(self, pid: int):
+        """
+        初始化读取器
+
+        Args:
+            pid: 游戏进程ID（HELLO协商响应中返回）
+        """
+        self.pid = pid
+        self.name = shm_name(pid)
+        self._map: Optional[mmap.mmap] = None
+
+    @property
+    def available(self) -> bool:
+        """通道是否已打开且有效"""
+        return self._map is not None
+
+    def open(self) -> bool:
+        """
+        映射共享内存并校验魔数
+
+        Returns:
+            True if通道可用
+        """
+        if self._map is not None:
+            return True
+        if sys.platform != 'win32':
+            return False
+
+        total_size = SHM_HEADER_SIZE + 2 * SHM_BUFFER_SIZE
+        try:
+            m = mmap.mmap(-1, total_size, tagname=self.name)
+        except (OSError, ValueError) as e:
+            logger.debug(f"Failed to map {self.name}: {e}")
+            return False
+
+        magic, version = struct.unpack_from('<II', m, 0)
+        if magic != SHM_MAGIC or version != SHM_VERSION:
+            # DLL未发布（mmap会创建空映射），回退到TCP路径
+            m.close()
+            return False
+
+        self._map = m
+        return True
+
+    def close(self):
+        """释放映射"""
+        if self._map is not None:
+            self._map.close()
+            self._map = None
+
+    def read_latest(self) -> Optional[Dict]:
+        """
+        读取最新状态快照
+
+        序列锁保证读到完整一致的帧；写端翻转期间自动重试。
+
+        Returns:
+            状态字典（同decode_state_frame），失败返回None
+        """
+        m = self._map
+        if m is None:
+            return None
+
+        for _ in range(_MAX_RETRIES):
+            (magic, _version, buffer_size, active,
+             seq0, seq1, len0, len1) = SHM_HEADER.unpack_from(m, 0)
+            if magic != SHM_MAGIC:
+                return None
+
+            idx = active & 1
+            seq_before = seq1 if idx else seq0
+            if seq_before & 1:
+                continue  # 写入中
+
+            frame_len = len1 if idx else len0
+            if frame_len < FRAME_HEADER.size or frame_len > buffer_size:
+                return None
+
+            offset = SHM_HEADER_SIZE + idx * buffer_size
+            frame = bytes(m[offset:offset + frame_len])
+
+            # 读取期间被覆盖则重试
+            seqs = SHM_HEADER.unpack_from(m, 0)[4:6]
+            if seqs[idx] != seq_before:
+                continue
+
+            frame_magic, length, frame_type = FRAME_HEADER.unpack_from(frame, 0)
+            if frame_magic != FRAME_MAGIC or frame_type != FrameType.STATE:
+                return None
+            return decode_state_frame(frame[FRAME_HEADER.size:FRAME_HEADER.size + length])
+
+        return None
+
+    def __enter__(self) -> 'SharedMemoryStateReader':
+        self.open()
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
@@ -383,6 +383,8 @@ def main():
     parser.add_argument("--no-collect", action="store_true", help="Disable auto-collecting")
     parser.add_argument("--no-log", action="store_true", help="Disable log file")
     parser.add_argument("--log-file", type=str, default=None, help="Log file path")
+    parser.add_argument("--record", type=str, default=None, metavar="FILE",
+                        help="Record per-step states to a binary replay file")
     args = parser.parse_args()
     
     # Setup logging
@@ -409,11 +411,20 @@ def main():
     import utils.logger as logger_module
     log_level = LogLevel.DEBUG if args.debug else LogLevel.INFO
     logger_module._global_logger = Logger("PVZ", level=log_level, file_path=log_file)
-    
+    if config.fast_status:
+        logger_module.enable_fast_status(config.status_drain_interval)
+
     logger = get_logger()
     
     # Create memory interface
     memory = PVZMemoryInterface()
+
+    # Optional trajectory recording
+    recorder = None
+    if args.record:
+        from replay import ReplayWriter
+        recorder = ReplayWriter(args.record)
+        print(f"🎬 轨迹将录制到: {args.record}")
     
     print("=" * 60)
     print("  PVZ Memory Interface")
@@ -466,6 +477,8 @@ def main():
             # Read and display state
             state = memory.get_game_state()
             if state:
+                if recorder:
+                    recorder.append_state(state)
                 log_status(
                     wave=state.wave,
                     total_waves=state.total_waves,
@@ -486,6 +499,10 @@ def main():
         print("\n")
         logger.info("Stopped by user")
     finally:
+        if recorder:
+            recorder.close()
+            logger.info(f"Recorded {recorder.steps} steps to {args.record}")
+        logger_module.disable_fast_status()
         if logger_module._global_logger:
             logger_module._global_logger.close()
 
@@ -0,0 +1,14 @@
+"""
+Replay Module
+Streaming binary trajectory recording for offline RL
+
+ReplayWriter appends per-step state frames (same fixed-layout entity
+records as the v2 hook protocol) delta-encoded, chunked and
+zlib-compressed; ReplayReader memory-maps a finished file and seeks
+any step through the index footer.
+"""
+
+from replay.writer import ReplayWriter
+from replay.reader import ReplayReader
+
+__all__ = ['ReplayWriter', 'ReplayReader']
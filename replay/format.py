@@ -0,0 +1,105 @@
+"""
+Replay File Format
+Binary layout shared by ReplayWriter and ReplayReader
+
+File layout:
+
+    FILE_HEADER                 magic 'PVZR' + version
+    chunk*                      CHUNK_HEADER + zlib(frames)
+    index                       INDEX_ENTRY per chunk
+    FOOTER                      entry count, index offset, total steps, magic
+
+Each decompressed chunk is a run of frames (RECORD_HEADER + payload).
+A chunk always starts with a keyframe (full v2 state payload); later
+frames may be XOR deltas against the previous frame's payload, which
+zlib then squeezes to a few bytes when little changed. Seeking is
+O(1) to the chunk via the index, then at most chunk_frames decodes.
+"""
+
+import struct
+from typing import List, Tuple
+
+from game.state import GameState
+from hook_client.protocol import (
+    STATE_HEADER, ZOMBIE_FIELDS, PLANT_FIELDS, SEED_FIELDS,
+)
+
+REPLAY_MAGIC = 0x525A5650  # 'PVZR' little-endian
+REPLAY_VERSION = 1
+
+FILE_HEADER = struct.Struct('<II')    # magic, version
+CHUNK_HEADER = struct.Struct('<IIII')  # raw_size, comp_size, frame_count, first_step
+RECORD_HEADER = struct.Struct('<BI')   # kind, payload_len
+INDEX_ENTRY = struct.Struct('<IQ')     # first_step, file_offset
+FOOTER = struct.Struct('<IQII')        # entry_count, index_offset, total_steps, magic
+
+# Frame kinds
+KEYFRAME = 0
+DELTA = 1
+
+
+def _record_struct(fields: List[Tuple[str, str]]) -> struct.Struct:
+    """Build a packer from a protocol dtype field table"""
+    return struct.Struct('<' + ''.join(
+        'f' if fmt == '<f4' else 'i' for _, fmt in fields))
+
+_ZOMBIE_RECORD = _record_struct(ZOMBIE_FIELDS)
+_PLANT_RECORD = _record_struct(PLANT_FIELDS)
+_SEED_RECORD = _record_struct(SEED_FIELDS)
+_ZOMBIE_NAMES = [name for name, _ in ZOMBIE_FIELDS]
+_PLANT_NAMES = [name for name, _ in PLANT_FIELDS]
+_SEED_NAMES = [name for name, _ in SEED_FIELDS]
+
+
+def encode_state_payload(state: GameState) -> bytes:
+    """
+    Encode a GameState snapshot as a v2 state-frame payload
+
+    The Python-side counterpart of State::GetGameStateBinary in the
+    hook DLL: identical header and record layouts, so recorded frames
+    decode with the same decode_state_frame used for live traffic.
+
+    Args:
+        state: Snapshot to encode
+
+    Returns:
+        Payload bytes (without the wire frame header)
+    """
+    zombies = state.alive_zombies
+    plants = state.alive_plants
+    seeds = state.seeds
+
+    parts = [STATE_HEADER.pack(
+        state.sun, state.wave, state.total_waves, state.scene,
+        state.game_clock, 1, len(zombies), len(plants), len(seeds))]
+
+    for z in zombies:
+        parts.append(_ZOMBIE_RECORD.pack(
+            *(getattr(z, name) for name in _ZOMBIE_NAMES)))
+    for p in plants:
+        parts.append(_PLANT_RECORD.pack(
+            *(int(getattr(p, name)) for name in _PLANT_NAMES)))
+    for s in seeds:
+        parts.append(_SEED_RECORD.pack(
+            *(int(getattr(s, name)) for name in _SEED_NAMES)))
+
+    return b''.join(parts)
+
+
+def xor_delta(prev: bytes, cur: bytes) -> bytes:
+    """
+    Delta-encode cur against prev (byte-wise XOR)
+
+    The result has cur's length; where the payloads overlap, unchanged
+    bytes become zero and compress away.
+    """
+    out = bytearray(cur)
+    n = min(len(prev), len(cur))
+    for i in range(n):
+        out[i] ^= prev[i]
+    return bytes(out)
+
+
+def apply_delta(prev: bytes, delta: bytes) -> bytes:
+    """Invert xor_delta: rebuild the full payload from prev + delta"""
+    return xor_delta(prev, delta)
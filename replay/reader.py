@@ -0,0 +1,140 @@
+"""
+Replay Reader
+Memory-mapped random access over recorded trajectories
+"""
+
+import bisect
+import mmap
+import zlib
+from typing import Iterator, List, Optional, Tuple
+
+from hook_client.protocol import decode_state_frame
+from replay.format import (
+    REPLAY_MAGIC, REPLAY_VERSION,
+    FILE_HEADER, CHUNK_HEADER, RECORD_HEADER, INDEX_ENTRY, FOOTER,
+    KEYFRAME, apply_delta,
+)
+
+
+class ReplayReader:
+    """
+    Random-access reader for replay files
+
+    The file is memory-mapped; reading step n touches only the chunk
+    containing it (located via the index footer), so dataloaders
+    sampling random steps never scan the whole trajectory. The last
+    decompressed chunk is cached for sequential access patterns.
+    """
+
+    def __init__(self, path: str):
+        """
+        Open and index a replay file
+
+        Args:
+            path: Replay file path
+
+        Raises:
+            ValueError: Not a replay file, or truncated (no footer)
+        """
+        self.path = path
+        self._file = open(path, 'rb')
+        self._map = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version = FILE_HEADER.unpack_from(self._map, 0)
+        if magic != REPLAY_MAGIC:
+            raise ValueError(f"Not a replay file: {path}")
+        if version != REPLAY_VERSION:
+            raise ValueError(f"Unsupported replay version {version}")
+
+        (entry_count, index_offset, total_steps,
+         footer_magic) = FOOTER.unpack_from(self._map, len(self._map) - FOOTER.size)
+        if footer_magic != REPLAY_MAGIC:
+            raise ValueError(f"Truncated replay (missing footer): {path}")
+
+        self.total_steps = total_steps
+        self._index: List[Tuple[int, int]] = []
+        for i in range(entry_count):
+            self._index.append(INDEX_ENTRY.unpack_from(
+                self._map, index_offset + i * INDEX_ENTRY.size))
+        self._chunk_steps = [entry[0] for entry in self._index]
+
+        # Cache of the last decompressed chunk: (chunk_idx, payload list)
+        self._cached_chunk: Optional[int] = None
+        self._cached_payloads: List[bytes] = []
+
+    def close(self):
+        """Release the mapping"""
+        if self._map is not None:
+            self._map.close()
+            self._map = None
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+
+    def __len__(self) -> int:
+        return self.total_steps
+
+    def _load_chunk(self, chunk_idx: int) -> List[bytes]:
+        """Decompress one chunk into full (delta-applied) payloads"""
+        if chunk_idx == self._cached_chunk:
+            return self._cached_payloads
+
+        _, offset = self._index[chunk_idx]
+        raw_size, comp_size, frame_count, _ = CHUNK_HEADER.unpack_from(
+            self._map, offset)
+        start = offset + CHUNK_HEADER.size
+        raw = zlib.decompress(self._map[start:start + comp_size])
+        if len(raw) != raw_size:
+            raise ValueError(f"Corrupt chunk {chunk_idx} in {self.path}")
+
+        payloads: List[bytes] = []
+        pos = 0
+        prev = b''
+        for _ in range(frame_count):
+            kind, length = RECORD_HEADER.unpack_from(raw, pos)
+            pos += RECORD_HEADER.size
+            data = raw[pos:pos + length]
+            pos += length
+            payload = data if kind == KEYFRAME else apply_delta(prev, data)
+            payloads.append(payload)
+            prev = payload
+
+        self._cached_chunk = chunk_idx
+        self._cached_payloads = payloads
+        return payloads
+
+    def read_payload(self, step: int) -> bytes:
+        """
+        Read the raw state payload for one step
+
+        Args:
+            step: Step index (0-based)
+
+        Returns:
+            v2 state-frame payload bytes
+        """
+        if not 0 <= step < self.total_steps:
+            raise IndexError(f"Step {step} out of range (0..{self.total_steps - 1})")
+        chunk_idx = bisect.bisect_right(self._chunk_steps, step) - 1
+        payloads = self._load_chunk(chunk_idx)
+        return payloads[step - self._chunk_steps[chunk_idx]]
+
+    def read_step(self, step: int) -> dict:
+        """
+        Read and decode one step
+
+        Returns:
+            State dict (same shape as decode_state_frame)
+        """
+        return decode_state_frame(self.read_payload(step))
+
+    def __iter__(self) -> Iterator[dict]:
+        """Iterate all steps in order"""
+        for step in range(self.total_steps):
+            yield self.read_step(step)
+
+    def __enter__(self) -> 'ReplayReader':
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
@@ -0,0 +1,117 @@
+"""
+Replay Writer
+Append-only recorder for per-step state frames
+"""
+
+import zlib
+from typing import List, Optional, Tuple
+
+from game.state import GameState
+from replay.format import (
+    REPLAY_MAGIC, REPLAY_VERSION,
+    FILE_HEADER, CHUNK_HEADER, RECORD_HEADER, INDEX_ENTRY, FOOTER,
+    KEYFRAME, DELTA, encode_state_payload, xor_delta,
+)
+
+
+class ReplayWriter:
+    """
+    Streaming trajectory recorder
+
+    Frames are buffered into chunks, delta-encoded against the
+    previous frame, and zlib-compressed on flush. Every chunk starts
+    with a keyframe so the reader never decodes across a chunk
+    boundary. close() appends the seek index and footer.
+    """
+
+    def __init__(self, path: str, keyframe_interval: int = 64,
+                 chunk_frames: int = 256, compression_level: int = 6):
+        """
+        Open a replay file for writing
+
+        Args:
+            path: Output file path
+            keyframe_interval: Max delta run before forcing a keyframe
+            chunk_frames: Frames per compressed chunk
+            compression_level: zlib level (1 fast .. 9 small)
+        """
+        self.path = path
+        self.keyframe_interval = keyframe_interval
+        self.chunk_frames = chunk_frames
+        self.compression_level = compression_level
+        self.steps = 0
+        self._file = open(path, 'wb')
+        self._file.write(FILE_HEADER.pack(REPLAY_MAGIC, REPLAY_VERSION))
+        self._chunk = bytearray()
+        self._chunk_count = 0
+        self._chunk_first_step = 0
+        self._since_keyframe = 0
+        self._prev_payload: Optional[bytes] = None
+        self._index: List[Tuple[int, int]] = []
+
+    def append_state(self, state: GameState):
+        """Encode and append one GameState snapshot"""
+        self.append_payload(encode_state_payload(state))
+
+    def append_payload(self, payload: bytes):
+        """
+        Append one already-encoded v2 state payload
+
+        Use this when recording from HookClient's binary channel to
+        skip re-encoding.
+        """
+        if self._file is None:
+            raise ValueError("ReplayWriter is closed")
+
+        keyframe = (self._prev_payload is None or
+                    self._chunk_count == 0 or
+                    self._since_keyframe >= self.keyframe_interval)
+        if keyframe:
+            kind, data = KEYFRAME, payload
+            self._since_keyframe = 0
+        else:
+            kind, data = DELTA, xor_delta(self._prev_payload, payload)
+            self._since_keyframe += 1
+
+        if self._chunk_count == 0:
+            self._chunk_first_step = self.steps
+        self._chunk += RECORD_HEADER.pack(kind, len(data))
+        self._chunk += data
+        self._chunk_count += 1
+        self._prev_payload = payload
+        self.steps += 1
+
+        if self._chunk_count >= self.chunk_frames:
+            self._flush_chunk()
+
+    def _flush_chunk(self):
+        """Compress and write the buffered chunk, record its index entry"""
+        if self._chunk_count == 0:
+            return
+        compressed = zlib.compress(bytes(self._chunk), self.compression_level)
+        self._index.append((self._chunk_first_step, self._file.tell()))
+        self._file.write(CHUNK_HEADER.pack(
+            len(self._chunk), len(compressed),
+            self._chunk_count, self._chunk_first_step))
+        self._file.write(compressed)
+        self._chunk = bytearray()
+        self._chunk_count = 0
+
+    def close(self):
+        """Flush remaining frames and append the index footer"""
+        if self._file is None:
+            return
+        self._flush_chunk()
+        index_offset = self._file.tell()
+        for first_step, offset in self._index:
+            self._file.write(INDEX_ENTRY.pack(first_step, offset))
+        self._file.write(FOOTER.pack(
+            len(self._index), index_offset, self.steps, REPLAY_MAGIC))
+        self._file.close()
+        self._file = None
+
+    def __enter__(self) -> 'ReplayWriter':
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        self.close()
@@ -0,0 +1,147 @@
+"""
+Perf Instrumentation Module
+Opt-in latency histograms for hot-path phases
+
+Counters are plain power-of-two bucket lists mutated without locks —
+increments are cheap and a (rare) lost increment under thread races is
+acceptable for telemetry. Everything is disabled by default; call
+enable() and the instrumented call sites in HookClient and GameReader
+start recording.
+"""
+
+import time
+from contextlib import contextmanager
+from typing import Callable, Dict, Optional
+
+# Bucket i holds samples in [2**(i-1), 2**i) microseconds;
+# 24 buckets cover 1us .. ~8.4s
+_NUM_BUCKETS = 24
+
+_enabled = False
+_histograms: Dict[str, 'LatencyHistogram'] = {}
+
+
+class LatencyHistogram:
+    """Power-of-two bucket latency histogram (microsecond resolution)"""
+
+    __slots__ = ('buckets', 'count', 'total_us', 'max_us')
+
+    def __init__(self):
+        self.buckets = [0] * _NUM_BUCKETS
+        self.count = 0
+        self.total_us = 0.0
+        self.max_us = 0.0
+
+    def record_us(self, us: float):
+        """Record one sample in microseconds"""
+        idx = min(max(int(us), 1).bit_length(), _NUM_BUCKETS - 1)
+        self.buckets[idx] += 1
+        self.count += 1
+        self.total_us += us
+        if us > self.max_us:
+            self.max_us = us
+
+    def percentile_us(self, p: float) -> float:
+        """Estimated percentile (upper bucket bound) in microseconds"""
+        if self.count == 0:
+            return 0.0
+        target = p * self.count
+        seen = 0
+        for i, n in enumerate(self.buckets):
+            seen += n
+            if seen >= target:
+                return float(1 << i)
+        return self.max_us
+
+    def summary(self) -> dict:
+        """Summarize as count/mean/p50/p99/max in milliseconds"""
+        if self.count == 0:
+            return {'count': 0}
+        return {
+            'count': self.count,
+            'mean_ms': self.total_us / self.count / 1000.0,
+            'p50_ms': self.percentile_us(0.50) / 1000.0,
+            'p99_ms': self.percentile_us(0.99) / 1000.0,
+            'max_ms': self.max_us / 1000.0,
+        }
+
+
+def enable():
+    """Turn on hot-path timing"""
+    global _enabled
+    _enabled = True
+
+
+def disable():
+    """Turn off hot-path timing (histograms are kept)"""
+    global _enabled
+    _enabled = False
+
+
+def enabled() -> bool:
+    """Whether instrumentation is currently recording"""
+    return _enabled
+
+
+def reset():
+    """Drop all recorded histograms"""
+    _histograms.clear()
+
+
+def record(name: str, seconds: float):
+    """Record one sample for a named phase"""
+    hist = _histograms.get(name)
+    if hist is None:
+        hist = _histograms.setdefault(name, LatencyHistogram())
+    hist.record_us(seconds * 1e6)
+
+
+def timed_call(name: str, fn: Callable, *args):
+    """Call fn(*args), recording its duration when enabled"""
+    if not _enabled:
+        return fn(*args)
+    start = time.perf_counter()
+    result = fn(*args)
+    record(name, time.perf_counter() - start)
+    return result
+
+
+@contextmanager
+def timed(name: str):
+    """Context manager timing its body when enabled"""
+    if not _enabled:
+        yield
+        return
+    start = time.perf_counter()
+    try:
+        yield
+    finally:
+        record(name, time.perf_counter() - start)
+
+
+def get_perf_stats(prefix: Optional[str] = None, reset_after: bool = False) -> dict:
+    """
+    Snapshot recorded histograms
+
+    Args:
+        prefix: Only include phases whose name starts with this
+        reset_after: Drop the returned histograms after snapshotting
+
+    Returns:
+        Dict of phase name -> summary dict
+    """
+    names = [n for n in _histograms if prefix is None or n.startswith(prefix)]
+    stats = {n: _histograms[n].summary() for n in sorted(names)}
+    if reset_after:
+        for n in names:
+            _histograms.pop(n, None)
+    return stats
+
+
+def format_line(prefix: Optional[str] = None) -> str:
+    """One-line compact summary (p50/p99 ms per phase) for status logs"""
+    parts = []
+    for name, s in get_perf_stats(prefix).items():
+        if s.get('count'):
+            parts.append(f"{name} {s['p50_ms']:.2f}/{s['p99_ms']:.2f}ms")
+    return " | ".join(parts)